@@ -10,27 +10,87 @@
 #ifndef AVL_TREE_H
 #define AVL_TREE_H
 
+#include <algorithm>
 #include <cstddef>
+#include <functional>
+#include <future>
 #include <iostream>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "frozen_tree.h"
+#include "node_pool.h"
+#include "three_way.h"
+#include "tree_file.h"
+#include "tree_print.h"
 using std::cout, std::endl;
 
-template <typename Comparable>
+// Values are ordered by Compare, std::less by default, and every walk down the tree
+// makes one three_way() comparison per node, see three_way.h.
+template <typename Comparable, template <typename> class NodeAllocator = NodePool, typename Compare = std::less<Comparable>>
 class AVLTree {
 private:
     static const int ALLOWED_IMBALANCE = 1; // the most difference between height allowed
+    static const std::size_t REMOVE_REBUILD_FACTOR = 2; // remove batches of at least twice size() values rebuild the tree in one pass
+    static const std::size_t PARALLEL_GRAIN = 16384; // subtrees smaller than this are never split across threads
+    static const unsigned BATCH_PROBES = 16; // lookups contains_batch() walks down the tree side by side
+    static const std::size_t BATCH_PROBE_MIN_SIZE = 262144; // smaller trees mostly stay cached, so contains_batch() just loops
 
     // struct for nodes of AVL tree
     struct avlNode {
         Comparable data;
         avlNode *left = nullptr;
         avlNode *right = nullptr;
+        avlNode *parent = nullptr;
         int height = 0;
+        std::size_t size = 1; // nodes in the subtree rooted here, for rank() and select()
     };
 
     avlNode* root; // root of avl Tree
+    NodeAllocator<avlNode> allocator; // storage for the nodes of the tree
+    Compare comp; // order of the values
+    std::size_t rotations = 0; // single rotations done so far, a double rotation counts as two
+    unsigned threads = 1; // most threads bulk operations may use, see set_parallelism()
+
+    // maps keep their entries in a tree and search it by key alone, see tree_map.h
+    template <typename Key, typename Value, typename Tree>
+    friend class TreeMap;
 
     // helper functions 
 
+    //-------------------------------------------------------
+    // Name: createNode(Args&&... args)
+    // PreCondition:  arguments for a Comparable constructor given
+    // PostCondition: returns a new leaf node whose data is built in place from args, taken from the allocator
+    //---------------------------------------------------------
+    template <typename... Args>
+    avlNode* createNode(Args&&... args) {
+        avlNode* n = this->allocator.allocate();
+        try {
+            new (n) avlNode{Comparable(std::forward<Args>(args)...)};
+        }
+        catch (...) { // give the storage back if building the data throws
+            this->allocator.deallocate(n);
+            throw;
+        }
+        return n;
+    }
+
+    //-------------------------------------------------------
+    // Name: destroyNode(avlNode* n)
+    // PreCondition:  node n unlinked from the tree
+    // PostCondition: destroys n and returns its storage to the allocator
+    //---------------------------------------------------------
+    void destroyNode(avlNode* n) {
+        n->~avlNode();
+        this->allocator.deallocate(n);
+    }
+
     //-------------------------------------------------------
     // Name: balance(avlNode*& t)
     // PreCondition:  node t given
@@ -60,6 +120,7 @@ private:
             }
         }
         t->height = std::max(height(t->left), height(t->right)) + 1;
+        t->size = subtreeSize(t->left) + subtreeSize(t->right) + 1;
     }
 
     //-------------------------------------------------------
@@ -76,350 +137,1813 @@ private:
     }
 
     //-------------------------------------------------------
-    // Name: insertSub(const Comparable& x, avlNode*& t)
-    // PreCondition:  Comparable x and avlNode t given
-    // PostCondition: inserts item of value x at avl tree root t through recursion and balances tree
+    // Name: linkTo(avlNode* n)
+    // PreCondition:  node n in the tree given
+    // PostCondition: returns the pointer that points at n, either its parent's left or right or the root
     //---------------------------------------------------------
-    void insertSub(const Comparable& x, avlNode*& t) {
-        if (t == nullptr) { // create node with data x
-            t = new avlNode;
-            t->data = x;
-        }
-        else if (x < t->data) { // shift left
-            insertSub(x, t->left);
+    avlNode*& linkTo(avlNode* n) {
+        if (n->parent == nullptr) {
+            return this->root;
         }
-        else if (x > t->data) { // shift right
-            insertSub(x, t->right );
-        }
-
-        balance(t);
+        return (n->parent->left == n) ? n->parent->left : n->parent->right;
     }
 
     //-------------------------------------------------------
-    // Name: removeSub(const Comparable& x, avlNode*& t)
-    // PreCondition:  Comparable x and avlNode t given
-    // PostCondition: removes item of value x at avl tree root t through recursion and balances tree
+    // Name: findNode(const Key& x)
+    // PreCondition:  Comparable x, or a key that compares with the values, given
+    // PostCondition: returns the node holding x, nullptr if x is not in the tree
     //---------------------------------------------------------
-    void removeSub(const Comparable& x, avlNode*& t) {
-        if (t == nullptr) {
-            return;
+    template <typename Key>
+    avlNode* findNode(const Key& x) const {
+        avlNode* t = this->root;
+        while (t != nullptr) {
+            int c = three_way(this->comp, x, t->data);
+            if (c == 0) {
+                break;
+            }
+            t = (c < 0) ? t->left : t->right;
         }
+        return t;
+    }
 
-        if (x < t->data) { // shift left
-            removeSub(x, t->left);
-        }
-        else if (x > t->data) { // shift right
-            removeSub(x, t->right);
-        }
-        else if (t->left != nullptr && t->right != nullptr) { // node has no children
-            t->data = find_min(t->right)->data;
-            removeSub(t->data, t->right);
-        }
-        else { // node has atleast one child
-            avlNode* r = t;
-            if (t->left != nullptr) {
-                t = t->left;
+    //-------------------------------------------------------
+    // Name: findSlot(const Key& x, avlNode*& parent)
+    // PreCondition:  Comparable x, or a key that compares with the values, given
+    // PostCondition: returns the empty link where x belongs and sets parent to the node owning it,
+    //                or returns nullptr and sets parent to the node holding x if x is already in the tree
+    //---------------------------------------------------------
+    template <typename Key>
+    avlNode** findSlot(const Key& x, avlNode*& parent) {
+        parent = nullptr;
+        avlNode** link = &this->root;
+        while (*link != nullptr) { // walk down to the empty spot for x
+            parent = *link;
+            int c = three_way(this->comp, x, parent->data);
+            if (c < 0) { // shift left
+                link = &parent->left;
             }
-            else {
-                t = t->right;
+            else if (c > 0) { // shift right
+                link = &parent->right;
+            }
+            else { // already in tree
+                return nullptr;
             }
-            delete r;
         }
-        balance(t);
+        return link;
     }
 
-    // rotators - helpers for balancing
+    //-------------------------------------------------------
+    // Name: attach(avlNode* n, avlNode* parent, avlNode** link)
+    // PreCondition:  new leaf n and the empty link and parent found for it by findSlot()
+    // PostCondition: hangs n from parent and balances the tree
+    //---------------------------------------------------------
+    void attach(avlNode* n, avlNode* parent, avlNode** link) {
+        n->parent = parent;
+        *link = n;
+        rebalanceFrom(parent);
+    }
 
     //-------------------------------------------------------
-    // Name: rotateWithLeftChild(avlNode*& k2)
-    // PreCondition:  avlNode k2 passed by reference that only has a left child
-    // PostCondition: shifts root k2 to the right and makes k1 its parent
+    // Name: hintSlot(const avlNode* next, const Comparable& x, avlNode*& parent)
+    // PreCondition:  node next that the caller expects to follow x in order, nullptr meaning x goes last
+    // PostCondition: same as findSlot(), but when x fits right before next the empty link is found
+    //                next to next or its predecessor without comparing down from the root
     //---------------------------------------------------------
-    void rotateWithLeftChild(avlNode*& k2) { 
-        // right shift
-        avlNode* k1 = k2->left;
-        k2->left = k1->right;
-        k1->right = k2;
-        k2->height = std::max(height(k2->left), height(k2->right)) + 1;
-        k1->height = std::max( height( k1->left ), k2->height ) + 1;
-        k2 = k1;
+    avlNode** hintSlot(const avlNode* next, const Comparable& x, avlNode*& parent) {
+        if (next == nullptr || this->comp(x, next->data)) {
+            const avlNode* prev;
+            if (next != nullptr) {
+                prev = predecessor(next);
+            }
+            else { // x goes after the maximum
+                prev = this->root;
+                while (prev != nullptr && prev->right != nullptr) {
+                    prev = prev->right;
+                }
+            }
+            if (prev == nullptr || this->comp(prev->data, x)) { // hint is right, x sits between prev and next
+                // one of the two always has its link towards the other free
+                if (prev != nullptr && prev->right == nullptr) {
+                    parent = const_cast<avlNode*>(prev);
+                    return &parent->right;
+                }
+                if (next != nullptr) {
+                    parent = const_cast<avlNode*>(next);
+                    return &parent->left;
+                }
+                parent = nullptr; // empty tree
+                return &this->root;
+            }
+        }
+        return findSlot(x, parent); // wrong hint
     }
 
     //-------------------------------------------------------
-    // Name: doubleWithLeftChild(avlNode*& k3)
-    // PreCondition:  avlNode k3 passed by reference that has children on both sides
-    // PostCondition: double shifts root k3 and balances its children
+    // Name: insertAt(avlNode** link, avlNode* parent, Args&&... args)
+    // PreCondition:  link and parent found by findSlot() or hintSlot() for the value args build, such as
+    //                the value itself as an lvalue or rvalue
+    // PostCondition: builds the value from args in a new node hung from link, unless link is nullptr because
+    //                the value is already there. Returns the node holding the value.
     //---------------------------------------------------------
-    void doubleWithLeftChild(avlNode*& k3) {
-        rotateWithRightChild(k3->left);
-        rotateWithLeftChild(k3);
+    template <typename... Args>
+    avlNode* insertAt(avlNode** link, avlNode* parent, Args&&... args) {
+        if (link == nullptr) { // already in tree, parent holds it
+            return parent;
+        }
+        avlNode* n = createNode(std::forward<Args>(args)...); // only built once we know it goes in
+        attach(n, parent, link);
+        return n;
     }
 
     //-------------------------------------------------------
-    // Name: rotateWithRightChild(avlNode*& k1)
-    // PreCondition:  avlNode k1 passed by reference that has child on right side
-    // PostCondition: shifts root k1 to left and makes right child its parent
+    // Name: removeNode(avlNode* t)
+    // PreCondition:  node t in the tree given
+    // PostCondition: unlinks and destroys t, then balances the tree
     //---------------------------------------------------------
-    void rotateWithRightChild(avlNode*& k1) {
-        // shift right
-        avlNode* k2 = k1->right;
-        k1->right = k2->left;
-        k2->left = k1;
-        k1->height = std::max(height(k1->left), height(k1->right)) + 1;
-        k2->height = std::max( height( k2->right ), k1->height ) + 1;
-        k1 = k2;
+    void removeNode(avlNode* t) {
+        avlNode* changed; // lowest node whose subtree lost a node
+        if (t->left != nullptr && t->right != nullptr) { // two children, successor node takes t's place
+            avlNode* s = find_min(t->right);
+            if (s->parent != t) { // unhook s from the bottom of the right subtree
+                changed = s->parent;
+                changed->left = s->right;
+                if (s->right != nullptr) {
+                    s->right->parent = changed;
+                }
+                s->right = t->right;
+                s->right->parent = s;
+            }
+            else {
+                changed = s;
+            }
+            s->left = t->left;
+            s->left->parent = s;
+            s->height = t->height;
+            s->size = t->size;
+            s->parent = t->parent;
+            linkTo(t) = s;
+        }
+        else { // at most one child, which moves up
+            avlNode* child = (t->left != nullptr) ? t->left : t->right;
+            if (child != nullptr) {
+                child->parent = t->parent;
+            }
+            changed = t->parent;
+            linkTo(t) = child;
+        }
+        destroyNode(t);
+        rebalanceFrom(changed);
     }
-    
+
     //-------------------------------------------------------
-    // Name: doubleWithRightChild(avlNode*& k3)
-    // PreCondition:  avlNode k3 passed by reference that has children on both sides
-    // PostCondition: double shifts root k3 and balances its children
+    // Name: removeKey(const Key& x)
+    // PreCondition:  Comparable x, or a key that compares with the values, given
+    // PostCondition: removes the node holding x in one walk down, returns whether there was one
     //---------------------------------------------------------
-    void doubleWithRightChild(avlNode*& k3) {
-        rotateWithLeftChild(k3->right);
-        rotateWithRightChild(k3);
+    template <typename Key>
+    bool removeKey(const Key& x) {
+        avlNode* t = findNode(x);
+        if (t == nullptr) {
+            return false;
+        }
+        removeNode(t);
+        return true;
     }
 
-    // print_tree() helper
     //-------------------------------------------------------
-    // Name: printTreeLine(avlNode* p, int space, std::ostream& os=std::cout)
-    // PreCondition:  root avlNode p given with value for space, and an ostream os that defaults to cout
-    // PostCondition: recursively prints tree rotated to os 90 degrees from root node p
+    // Name: rebalanceFrom(avlNode* p)
+    // PreCondition:  node p is the lowest node whose subtree changed, or nullptr
+    // PostCondition: balances p and its ancestors, stopping at the first one whose height did not change,
+    //                then brings the subtree sizes of the rest of the ancestors up to date
     //---------------------------------------------------------
-    void printTreeLine(avlNode* p, int space, std::ostream& os=std::cout) const {
-        if (p == nullptr) {
-            return;
+    void rebalanceFrom(avlNode* p) {
+        while (p != nullptr) {
+            int oldHeight = p->height;
+            avlNode* parent = p->parent;
+            avlNode*& t = linkTo(p);
+            balance(t);
+            p = parent;
+            if (t->height == oldHeight) { // no balancing needed above
+                break;
+            }
         }
-        space++; // amount of levels
-        printTreeLine(p->right, space, os);
-        for (int i = 1; i < space; i++) {
-            os << "  ";
+        while (p != nullptr) { // sizes still change on the rest of the path
+            p->size = subtreeSize(p->left) + subtreeSize(p->right) + 1;
+            p = p->parent;
         }
-        os << p->data << endl;
-        printTreeLine(p->left, space, os);
-        return;
     }
 
-    // copy constructor and assignment operator helper
+    // join helpers - combine trees of any size in time proportional to the difference in their heights
 
     //-------------------------------------------------------
-    // Name: copyTree(avlNode* p)
-    // PreCondition:  root node p given
-    // PostCondition: Deep copys root node p and children recursively and returns a copy of node p that has a copy of its children
+    // Name: joinNodes(avlNode* l, avlNode* k, avlNode* r)
+    // PreCondition:  trees l and r, every value in l less than k's and every value in r greater, node k in neither
+    // PostCondition: returns the root of a balanced tree holding l, k and r, with no parent
     //---------------------------------------------------------
-    avlNode* copyTree(avlNode* p) {
-        // copying contents
-        avlNode* c = new avlNode;
-        c->data = p->data;
-        c->height = p->height;
-
-        // copying children
-        if (p->left != nullptr) {
-            c->left = copyTree(p->left);
+    avlNode* joinNodes(avlNode* l, avlNode* k, avlNode* r) {
+        avlNode* t;
+        if (height(l) > height(r) + ALLOWED_IMBALANCE) {
+            t = joinRight(l, k, r);
         }
-        if (p->right != nullptr) {
-            c->right = copyTree(p->right);
+        else if (height(r) > height(l) + ALLOWED_IMBALANCE) {
+            t = joinLeft(l, k, r);
         }
-        return c;
+        else { // close enough in height, k goes on top
+            t = k;
+            linkChildren(t, l, r);
+        }
+        t->parent = nullptr;
+        return t;
     }
 
-    // destructor helper
-
     //-------------------------------------------------------
-    // Name: destroy(avlNode*& p)
-    // PreCondition:  root node p given
-    // PostCondition: Deletes node p and children recursively
+    // Name: joinRight(avlNode* l, avlNode* k, avlNode* r)
+    // PreCondition:  same as joinNodes(), l more than one level taller than r
+    // PostCondition: hangs k and r down the right spine of l where the heights match, balancing on the way back up
     //---------------------------------------------------------
-    void destroy(avlNode*& p) {
-        if (p != nullptr) {
-            destroy(p->left);
-            destroy(p->right);
-            delete p;
+    avlNode* joinRight(avlNode* l, avlNode* k, avlNode* r) {
+        avlNode* t;
+        if (height(l->right) <= height(r) + ALLOWED_IMBALANCE) { // k can sit here with l->right and r below it
+            t = k;
+            linkChildren(t, l->right, r);
+        }
+        else {
+            t = joinRight(l->right, k, r);
         }
-        return;
+        l->right = t;
+        t->parent = l;
+        balance(l); // right side is at most two levels taller
+        return l;
     }
-    
-    // helper for balance and rotations
 
     //-------------------------------------------------------
-    // Name: height(avlNode* t)
-    // PreCondition:  node t given
-    // PostCondition: returns int height of node t
+    // Name: joinLeft(avlNode* l, avlNode* k, avlNode* r)
+    // PreCondition:  same as joinNodes(), r more than one level taller than l
+    // PostCondition: hangs l and k down the left spine of r where the heights match, balancing on the way back up
     //---------------------------------------------------------
-    int height(avlNode* t) {
-        if (t == nullptr) {
-            return -1;
+    avlNode* joinLeft(avlNode* l, avlNode* k, avlNode* r) {
+        avlNode* t;
+        if (height(r->left) <= height(l) + ALLOWED_IMBALANCE) { // k can sit here with l and r->left below it
+            t = k;
+            linkChildren(t, l, r->left);
         }
         else {
-            return t->height;
+            t = joinLeft(l, k, r->left);
         }
+        r->left = t;
+        t->parent = r;
+        balance(r); // left side is at most two levels taller
+        return r;
     }
 
-public:
-    // constructors 
+    //-------------------------------------------------------
+    // Name: joinNodes(avlNode* l, avlNode* r)
+    // PreCondition:  trees l and r, every value in l less than every value in r
+    // PostCondition: returns the root of a balanced tree holding l and r, using the maximum of l to join them
+    //---------------------------------------------------------
+    avlNode* joinNodes(avlNode* l, avlNode* r) {
+        if (l == nullptr) {
+            if (r != nullptr) {
+                r->parent = nullptr;
+            }
+            return r;
+        }
+        avlNode* max;
+        l = removeMax(l, max);
+        return joinNodes(l, max, r);
+    }
 
     //-------------------------------------------------------
-    // Name: AVLTree()
-    // PreCondition: none
-    // PostCondition: creates new AVLTree object and sets root to nullptr
+    // Name: removeMax(avlNode* t, avlNode*& max)
+    // PreCondition:  tree t that is not empty
+    // PostCondition: unlinks the node holding the maximum into max and returns the balanced root of what is left
     //---------------------------------------------------------
-    AVLTree() {
-        this->root = nullptr;
+    avlNode* removeMax(avlNode* t, avlNode*& max) {
+        if (t->right == nullptr) {
+            max = t;
+            if (t->left != nullptr) {
+                t->left->parent = t->parent;
+            }
+            return t->left;
+        }
+        t->right = removeMax(t->right, max);
+        balance(t);
+        return t;
     }
 
     //-------------------------------------------------------
-    // Name: AVLTree(const AVLTree& other)
-    // PreCondition: AVLTree other passed by reference
-    // PostCondition: creates new object AVLTree that is a copy of other
+    // Name: linkChildren(avlNode* t, avlNode* l, avlNode* r)
+    // PreCondition:  node t and trees l and r that are at most one level apart in height
+    // PostCondition: makes l and r the children of t and updates its height and size
     //---------------------------------------------------------
-    AVLTree(const AVLTree& other) {
-        this->root = copyTree(other.root);
+    void linkChildren(avlNode* t, avlNode* l, avlNode* r) {
+        t->left = l;
+        t->right = r;
+        if (l != nullptr) {
+            l->parent = t;
+        }
+        if (r != nullptr) {
+            r->parent = t;
+        }
+        t->height = std::max(height(l), height(r)) + 1;
+        t->size = subtreeSize(l) + subtreeSize(r) + 1;
     }
 
-    // destructor
+    // batch helpers
 
     //-------------------------------------------------------
-    // Name: ~AVLTree()
-    // PreCondition: AVLTree object has already been created
-    // PostCondition: destroys all nodes and root of AVLTree object and sets root to nullptr
+    // Name: unionSorted(avlNode* t, Comparable* first, Comparable* last)
+    // PreCondition:  tree t and strictly increasing values first to last
+    // PostCondition: moves the values not in t into new nodes and returns the root of the combined tree.
+    //                The values are split around the root and each side joined back in,
+    //                O(m log(n / m + 1)) for m values and n nodes.
     //---------------------------------------------------------
-    ~AVLTree() {
-        destroy(this->root);
-        this->root = nullptr;
+    avlNode* unionSorted(avlNode* t, Comparable* first, Comparable* last) {
+        if (first == last) {
+            return t;
+        }
+        if (t == nullptr) {
+            return buildTree(std::make_move_iterator(first), static_cast<std::size_t>(last - first));
+        }
+        Comparable* mid = std::lower_bound(first, last, t->data, this->comp);
+        Comparable* rightFirst = (mid != last && !this->comp(t->data, *mid)) ? mid + 1 : mid; // skip a value already in t
+        avlNode* l = unionSorted(t->left, first, mid);
+        avlNode* r = unionSorted(t->right, rightFirst, last);
+        return joinNodes(l, t, r);
     }
 
-    // assignment operator
+    //-------------------------------------------------------
+    // Name: differenceSorted(avlNode* t, const Comparable* first, const Comparable* last)
+    // PreCondition:  tree t and strictly increasing values first to last
+    // PostCondition: destroys the nodes of t holding one of the values and returns the root of what is left,
+    //                O(m log(n / m + 1)) for m values and n nodes
+    //---------------------------------------------------------
+    avlNode* differenceSorted(avlNode* t, const Comparable* first, const Comparable* last) {
+        if (t == nullptr || first == last) {
+            return t;
+        }
+        const Comparable* mid = std::lower_bound(first, last, t->data, this->comp);
+        bool found = (mid != last && !this->comp(t->data, *mid));
+        avlNode* l = differenceSorted(t->left, first, mid);
+        avlNode* r = differenceSorted(t->right, found ? mid + 1 : mid, last);
+        if (found) {
+            destroyNode(t);
+            return joinNodes(l, r);
+        }
+        return joinNodes(l, t, r);
+    }
 
     //-------------------------------------------------------
-    // Name: operator=(const AVLTree& other)
-    // PreCondition: AVLTree other passed by reference
-    // PostCondition: return copy of other, having changed this object 
+    // Name: collectNodes(avlNode* t, std::vector<avlNode*>& nodes)
+    // PreCondition:  tree t given
+    // PostCondition: appends the nodes of t to nodes in order
     //---------------------------------------------------------
-    AVLTree& operator=(const AVLTree& other) {
-        if (this != &other) { // if not same object
-            if (!is_empty()) {
-                destroy(this->root);
-                this->root = nullptr;
+    static void collectNodes(avlNode* t, std::vector<avlNode*>& nodes) {
+        std::vector<avlNode*> pending; // nodes whose left side has been visited but not themselves
+        while (t != nullptr || !pending.empty()) {
+            while (t != nullptr) { // go as far left as possible
+                pending.push_back(t);
+                t = t->left;
             }
-            this->root = copyTree(other.root);
+            t = pending.back();
+            pending.pop_back();
+            nodes.push_back(t);
+            t = t->right;
         }
-        return *this;
     }
 
     //-------------------------------------------------------
-    // Name: contains(const Comparable& value)
-    // PreCondition: Comparable value passed by reference
-    // PostCondition: return true if value is a node in the tree, false if not
+    // Name: relinkNodes(avlNode** nodes, std::size_t n)
+    // PreCondition:  n nodes in order starting at nodes
+    // PostCondition: links the nodes into a perfectly balanced tree with heights and sizes set and returns its root
     //---------------------------------------------------------
-    bool contains(const Comparable& value) const {
-        if (is_empty()) { // empty tree
-            return false;
+    avlNode* relinkNodes(avlNode** nodes, std::size_t n) {
+        if (n == 0) {
+            return nullptr;
         }
+        std::size_t mid = n / 2; // middle node becomes the root
+        avlNode* t = nodes[mid];
+        linkChildren(t, relinkNodes(nodes, mid), relinkNodes(nodes + mid + 1, n - mid - 1));
+        return t;
+    }
 
-        avlNode* current = this->root;
-
-        while (current != nullptr) {
-            if (current->data == value) { // value in tree
-                return true;
+    //-------------------------------------------------------
+    // Name: filterRebuild(const std::vector<Comparable>& values)
+    // PreCondition:  strictly increasing values
+    // PostCondition: destroys the nodes holding one of the values and relinks the rest into a perfectly
+    //                balanced tree, O(n + m)
+    //---------------------------------------------------------
+    void filterRebuild(const std::vector<Comparable>& values) {
+        std::vector<avlNode*> nodes;
+        nodes.reserve(size());
+        collectNodes(this->root, nodes);
+        std::size_t kept = 0;
+        std::size_t j = 0;
+        for (avlNode* n : nodes) {
+            while (j < values.size() && this->comp(values[j], n->data)) { // values that are not in the tree
+                j++;
             }
-            else if (current->data > value) { // shift left
-                current = current->left;
+            if (j < values.size() && !this->comp(n->data, values[j])) { // removed
+                destroyNode(n);
+                j++;
             }
-            else { // shift right
-                current = current->right;
+            else {
+                nodes[kept++] = n;
             }
         }
-
-        // not in tree
-        return false;
+        this->root = relinkNodes(nodes.data(), kept);
+        if (this->root != nullptr) {
+            this->root->parent = nullptr;
+        }
     }
 
     //-------------------------------------------------------
-    // Name: insert(const Comparable& value)
-    // PreCondition: Comparable value passed by reference
-    // PostCondition: creates a node with value as its data and puts it into tree, balancing it as well
+    // Name: sortedBatch(InputIt first, InputIt last)
+    // PreCondition:  range of values first to last given
+    // PostCondition: returns the values of the range sorted with duplicates dropped
     //---------------------------------------------------------
-    void insert(const Comparable& value) {
-        insertSub(value, this->root);
+    template <typename InputIt>
+    std::vector<Comparable> sortedBatch(InputIt first, InputIt last) const {
+        std::vector<Comparable> values(first, last);
+        sortUnique(values);
+        return values;
     }
 
     //-------------------------------------------------------
-    // Name: remove(const Comparable& value)
-    // PreCondition: Comparable value passed by reference
-    // PostCondition: remove a node with value and balances the tree
+    // Name: sortUnique(std::vector<Comparable>& values)
+    // PreCondition:  values given
+    // PostCondition: sorts values in the order of the tree, skipping the sort if they already are, and drops equivalent ones
     //---------------------------------------------------------
-    void remove(const Comparable& value) {
-        removeSub(value, this->root);
+    void sortUnique(std::vector<Comparable>& values) const {
+        if (!std::is_sorted(values.begin(), values.end(), this->comp)) {
+            std::sort(values.begin(), values.end(), this->comp);
+        }
+        values.erase(std::unique(values.begin(), values.end(), [this](const Comparable& a, const Comparable& b) {
+            return !this->comp(a, b); // sorted, so a is not after b
+        }), values.end());
     }
 
+    // split and set operation helpers
+
     //-------------------------------------------------------
-    // Name: find_min()
-    // PreCondition: root is not a nullptr
-    // PostCondition: returns the Comparable data of the minimum value node in the tree
+    // Name: splitNodes(avlNode* t, const Comparable& key, avlNode*& l, avlNode*& r)
+    // PreCondition:  tree t and Comparable key given
+    // PostCondition: splits t into l holding the values less than key and r holding the values greater,
+    //                returning the unlinked node holding key or nullptr, O(log n)
     //---------------------------------------------------------
-    const Comparable& find_min() const {
-        if (this->root == nullptr) {
-            throw std::invalid_argument("AVLTree is empty");
+    avlNode* splitNodes(avlNode* t, const Comparable& key, avlNode*& l, avlNode*& r) {
+        if (t == nullptr) {
+            l = nullptr;
+            r = nullptr;
+            return nullptr;
+        }
+        avlNode* tl = t->left;
+        avlNode* tr = t->right;
+        avlNode* found;
+        int c = three_way(this->comp, key, t->data);
+        if (c < 0) { // t and its right side go right
+            avlNode* middle;
+            found = splitNodes(tl, key, l, middle);
+            r = joinNodes(middle, t, tr);
+        }
+        else if (c > 0) { // t and its left side go left
+            avlNode* middle;
+            found = splitNodes(tr, key, middle, r);
+            l = joinNodes(tl, t, middle);
+        }
+        else {
+            l = tl;
+            r = tr;
+            found = t;
+        }
+        if (l != nullptr) {
+            l->parent = nullptr;
         }
+        if (r != nullptr) {
+            r->parent = nullptr;
+        }
+        return found;
+    }
 
-        avlNode* current = this->root;
-        while (current->left != nullptr) { // get to leftmost node
-            current = current->left;
+    //-------------------------------------------------------
+    // Name: unionNodes(avlNode* a, avlNode* b)
+    // PreCondition:  trees a and b whose nodes both belong to this tree's allocator
+    // PostCondition: returns the root of a tree holding the values of both, freeing b's duplicates.
+    //                b is split around the root of a and each side merged in, O(m log(n / m + 1))
+    //                for trees of m and n values with m <= n.
+    //---------------------------------------------------------
+    avlNode* unionNodes(avlNode* a, avlNode* b) {
+        if (a == nullptr) {
+            return b;
         }
-        return current->data;
+        if (b == nullptr) {
+            return a;
+        }
+        avlNode* bl;
+        avlNode* br;
+        avlNode* duplicate = splitNodes(b, a->data, bl, br);
+        if (duplicate != nullptr) {
+            destroyNode(duplicate);
+        }
+        avlNode* l = unionNodes(a->left, bl);
+        avlNode* r = unionNodes(a->right, br);
+        return joinNodes(l, a, r);
     }
 
     //-------------------------------------------------------
-    // Name: find_max()
-    // PreCondition: root is not a nullptr
-    // PostCondition: returns the data of the maximum value node in the tree
+    // Name: intersectNodes(avlNode* a, avlNode* b)
+    // PreCondition:  trees a and b whose nodes both belong to this tree's allocator
+    // PostCondition: returns the root of a tree holding the values in both, freeing every other node,
+    //                O(m log(n / m + 1))
     //---------------------------------------------------------
-    const Comparable& find_max() const {
-        if (this->root == nullptr) {
-            throw std::invalid_argument("AVLTree is empty");
+    avlNode* intersectNodes(avlNode* a, avlNode* b) {
+        if (a == nullptr || b == nullptr) {
+            freeNodes(a);
+            freeNodes(b);
+            return nullptr;
         }
-        avlNode* current = this->root;
-        while (current->right != nullptr) { // get to rightmost node
-            current = current->right;
+        avlNode* bl;
+        avlNode* br;
+        avlNode* match = splitNodes(b, a->data, bl, br);
+        avlNode* l = intersectNodes(a->left, bl);
+        avlNode* r = intersectNodes(a->right, br);
+        if (match != nullptr) { // a's root stays, b's copy of it goes
+            destroyNode(match);
+            return joinNodes(l, a, r);
         }
-        return current->data;
+        destroyNode(a);
+        return joinNodes(l, r);
     }
 
     //-------------------------------------------------------
-    // Name: print_tree(std::ostream& os=std::cout)
-    // PreCondition: ostream os defaults to cout if none given
-    // PostCondition: prints 90 degree rotated tree to os
+    // Name: differenceNodes(avlNode* a, avlNode* b)
+    // PreCondition:  trees a and b whose nodes both belong to this tree's allocator
+    // PostCondition: returns the root of a tree holding the values of a that are not in b, freeing every other node.
+    //                a is split around the root of b, O(m log(n / m + 1)).
     //---------------------------------------------------------
-    void print_tree(std::ostream& os=std::cout) const {
-        if (!is_empty()) {
-            this->printTreeLine(this->root, 0, os);
+    avlNode* differenceNodes(avlNode* a, avlNode* b) {
+        if (a == nullptr || b == nullptr) {
+            freeNodes(b);
+            return a;
         }
-        else { // empty tree
-            os << "<empty>\n";
+        avlNode* al;
+        avlNode* ar;
+        avlNode* match = splitNodes(a, b->data, al, ar);
+        if (match != nullptr) {
+            destroyNode(match);
         }
+        avlNode* l = differenceNodes(al, b->left);
+        avlNode* r = differenceNodes(ar, b->right);
+        destroyNode(b);
+        return joinNodes(l, r);
     }
 
     //-------------------------------------------------------
-    // Name: is_empty()
-    // PreCondition: none
-    // PostCondition: returns true if tree is empty, false if it isnt
+    // Name: freeNodes(avlNode* t)
+    // PreCondition:  tree t unlinked from the rest of the tree
+    // PostCondition: destroys every node of t and returns its storage to the allocator
     //---------------------------------------------------------
-    bool is_empty() const { return (this->root == nullptr); }
+    void freeNodes(avlNode* t) {
+        if (t != nullptr) {
+            freeNodes(t->left);
+            freeNodes(t->right);
+            destroyNode(t);
+        }
+    }
 
     //-------------------------------------------------------
-    // Name: make_empty()
-    // PreCondition: none
-    // PostCondition: destroys all nodes, including root of tree, making it empyu.
+    // Name: takeNodes(AVLTree& other)
+    // PreCondition:  other given
+    // PostCondition: returns other's root for this tree to link in, after this tree's allocator adopted other's storage,
+    //                leaving other empty
     //---------------------------------------------------------
-    void make_empty() { 
-        destroy(this->root); 
-        this->root = nullptr;
+    avlNode* takeNodes(AVLTree& other) {
+        avlNode* t = other.root;
+        other.root = nullptr;
+        this->allocator.adopt(other.allocator);
+        return t;
+    }
+
+    // parallel helpers - each forked task works on its own worker tree, so allocators and rotation
+    // counts are never shared between threads, and the worker's storage is adopted once it is done
+
+    //-------------------------------------------------------
+    // Name: forkDepth()
+    // PreCondition:  none
+    // PostCondition: returns how many levels of the recursion may fork, enough for one leaf task per thread
+    //---------------------------------------------------------
+    int forkDepth() const {
+        int depth = 0;
+        while ((1u << depth) < this->threads) {
+            depth++;
+        }
+        return depth;
+    }
+
+    //-------------------------------------------------------
+    // Name: forkJoin(Left left, Right right)
+    // PreCondition:  tasks left and right that each build a tree from nodes no other task touches
+    // PostCondition: runs left on a new thread with a worker tree and right on this tree at the same time,
+    //                takes over the worker's storage and returns the roots the two tasks built
+    //---------------------------------------------------------
+    template <typename Left, typename Right>
+    std::pair<avlNode*, avlNode*> forkJoin(Left left, Right right) {
+        AVLTree worker(this->comp); // walks and joins the nodes in the same order as this tree
+        std::future<avlNode*> forked = std::async(std::launch::async, [&worker, &left] { return left(worker); });
+        avlNode* r = right(*this);
+        avlNode* l = forked.get();
+        this->allocator.adopt(worker.allocator);
+        this->rotations += worker.rotations;
+        return {l, r};
     }
 
-    // optional
-    // AVLTree(AVLTree&& other);
-    // AVLTree& operator=(AVLTree&& other);
-    // void insert(Comparable&& value);
+    //-------------------------------------------------------
+    // Name: buildParallel(RandomIt first, std::size_t n, int depth)
+    // PreCondition:  n strictly increasing values starting at first, depth levels left to fork
+    // PostCondition: same as buildTree(), building the two halves on separate threads
+    //---------------------------------------------------------
+    template <typename RandomIt>
+    avlNode* buildParallel(RandomIt first, std::size_t n, int depth) {
+        if (depth == 0 || n < PARALLEL_GRAIN) {
+            return buildTree(first, n);
+        }
+        std::size_t mid = n / 2; // middle value becomes the root
+        avlNode* t = createNode(first[mid]);
+        std::pair<avlNode*, avlNode*> sides = forkJoin(
+            [first, mid, depth](AVLTree& tree) { return tree.buildParallel(first, mid, depth - 1); },
+            [first, mid, n, depth](AVLTree& tree) { return tree.buildParallel(first + mid + 1, n - mid - 1, depth - 1); });
+        linkChildren(t, sides.first, sides.second);
+        return t;
+    }
+
+    //-------------------------------------------------------
+    // Name: copyParallel(avlNode* p, int depth)
+    // PreCondition:  root node p given, depth levels left to fork
+    // PostCondition: same as copyTree(), copying the two subtrees of p on separate threads
+    //---------------------------------------------------------
+    avlNode* copyParallel(avlNode* p, int depth) {
+        if (depth == 0 || subtreeSize(p) < PARALLEL_GRAIN) {
+            return copyTree(p);
+        }
+        avlNode* c = createNode(p->data);
+        avlNode* pl = p->left;
+        avlNode* pr = p->right;
+        std::pair<avlNode*, avlNode*> sides = forkJoin(
+            [pl, depth](AVLTree& tree) { return tree.copyParallel(pl, depth - 1); },
+            [pr, depth](AVLTree& tree) { return tree.copyParallel(pr, depth - 1); });
+        linkChildren(c, sides.first, sides.second);
+        return c;
+    }
+
+    //-------------------------------------------------------
+    // Name: unionParallel(avlNode* a, avlNode* b, int depth)
+    // PreCondition:  same as unionNodes(), depth levels left to fork
+    // PostCondition: same as unionNodes(), merging into the two subtrees of a on separate threads
+    //---------------------------------------------------------
+    avlNode* unionParallel(avlNode* a, avlNode* b, int depth) {
+        if (depth == 0 || a == nullptr || b == nullptr || subtreeSize(a) + subtreeSize(b) < PARALLEL_GRAIN) {
+            return unionNodes(a, b);
+        }
+        avlNode* bl;
+        avlNode* br;
+        avlNode* duplicate = splitNodes(b, a->data, bl, br);
+        if (duplicate != nullptr) {
+            destroyNode(duplicate);
+        }
+        avlNode* al = a->left;
+        avlNode* ar = a->right;
+        std::pair<avlNode*, avlNode*> sides = forkJoin(
+            [al, bl, depth](AVLTree& tree) { return tree.unionParallel(al, bl, depth - 1); },
+            [ar, br, depth](AVLTree& tree) { return tree.unionParallel(ar, br, depth - 1); });
+        return joinNodes(sides.first, a, sides.second);
+    }
+
+    //-------------------------------------------------------
+    // Name: intersectParallel(avlNode* a, avlNode* b, int depth)
+    // PreCondition:  same as intersectNodes(), depth levels left to fork
+    // PostCondition: same as intersectNodes(), intersecting the two subtrees of a on separate threads
+    //---------------------------------------------------------
+    avlNode* intersectParallel(avlNode* a, avlNode* b, int depth) {
+        if (depth == 0 || a == nullptr || b == nullptr || subtreeSize(a) + subtreeSize(b) < PARALLEL_GRAIN) {
+            return intersectNodes(a, b);
+        }
+        avlNode* bl;
+        avlNode* br;
+        avlNode* match = splitNodes(b, a->data, bl, br);
+        avlNode* al = a->left;
+        avlNode* ar = a->right;
+        std::pair<avlNode*, avlNode*> sides = forkJoin(
+            [al, bl, depth](AVLTree& tree) { return tree.intersectParallel(al, bl, depth - 1); },
+            [ar, br, depth](AVLTree& tree) { return tree.intersectParallel(ar, br, depth - 1); });
+        if (match != nullptr) { // a's root stays, b's copy of it goes
+            destroyNode(match);
+            return joinNodes(sides.first, a, sides.second);
+        }
+        destroyNode(a);
+        return joinNodes(sides.first, sides.second);
+    }
+
+    //-------------------------------------------------------
+    // Name: differenceParallel(avlNode* a, avlNode* b, int depth)
+    // PreCondition:  same as differenceNodes(), depth levels left to fork
+    // PostCondition: same as differenceNodes(), working on the two sides of b's root on separate threads
+    //---------------------------------------------------------
+    avlNode* differenceParallel(avlNode* a, avlNode* b, int depth) {
+        if (depth == 0 || a == nullptr || b == nullptr || subtreeSize(a) + subtreeSize(b) < PARALLEL_GRAIN) {
+            return differenceNodes(a, b);
+        }
+        avlNode* al;
+        avlNode* ar;
+        avlNode* match = splitNodes(a, b->data, al, ar);
+        if (match != nullptr) {
+            destroyNode(match);
+        }
+        avlNode* bl = b->left;
+        avlNode* br = b->right;
+        std::pair<avlNode*, avlNode*> sides = forkJoin(
+            [al, bl, depth](AVLTree& tree) { return tree.differenceParallel(al, bl, depth - 1); },
+            [ar, br, depth](AVLTree& tree) { return tree.differenceParallel(ar, br, depth - 1); });
+        destroyNode(b);
+        return joinNodes(sides.first, sides.second);
+    }
+
+    //-------------------------------------------------------
+    // Name: copyOf(const AVLTree& other)
+    // PreCondition:  other given
+    // PostCondition: returns a copy of other's nodes taken from this tree's allocator, in parallel if allowed
+    //---------------------------------------------------------
+    avlNode* copyOf(const AVLTree& other) {
+        return copyParallel(other.root, forkDepth());
+    }
+
+    // rotators - helpers for balancing
+
+    //-------------------------------------------------------
+    // Name: rotateWithLeftChild(avlNode*& k2)
+    // PreCondition:  avlNode k2 passed by reference that only has a left child
+    // PostCondition: shifts root k2 to the right and makes k1 its parent
+    //---------------------------------------------------------
+    void rotateWithLeftChild(avlNode*& k2) { 
+        // right shift
+        avlNode* k1 = k2->left;
+        k2->left = k1->right;
+        if (k2->left != nullptr) {
+            k2->left->parent = k2;
+        }
+        k1->right = k2;
+        k1->parent = k2->parent;
+        k2->parent = k1;
+        this->rotations++;
+        k2->height = std::max(height(k2->left), height(k2->right)) + 1;
+        k1->height = std::max( height( k1->left ), k2->height ) + 1;
+        k2->size = subtreeSize(k2->left) + subtreeSize(k2->right) + 1;
+        k1->size = subtreeSize(k1->left) + k2->size + 1;
+        k2 = k1;
+    }
+
+    //-------------------------------------------------------
+    // Name: doubleWithLeftChild(avlNode*& k3)
+    // PreCondition:  avlNode k3 passed by reference that has children on both sides
+    // PostCondition: double shifts root k3 and balances its children
+    //---------------------------------------------------------
+    void doubleWithLeftChild(avlNode*& k3) {
+        rotateWithRightChild(k3->left);
+        rotateWithLeftChild(k3);
+    }
+
+    //-------------------------------------------------------
+    // Name: rotateWithRightChild(avlNode*& k1)
+    // PreCondition:  avlNode k1 passed by reference that has child on right side
+    // PostCondition: shifts root k1 to left and makes right child its parent
+    //---------------------------------------------------------
+    void rotateWithRightChild(avlNode*& k1) {
+        // shift right
+        avlNode* k2 = k1->right;
+        k1->right = k2->left;
+        if (k1->right != nullptr) {
+            k1->right->parent = k1;
+        }
+        k2->left = k1;
+        k2->parent = k1->parent;
+        k1->parent = k2;
+        this->rotations++;
+        k1->height = std::max(height(k1->left), height(k1->right)) + 1;
+        k2->height = std::max( height( k2->right ), k1->height ) + 1;
+        k1->size = subtreeSize(k1->left) + subtreeSize(k1->right) + 1;
+        k2->size = subtreeSize(k2->right) + k1->size + 1;
+        k1 = k2;
+    }
+    
+    //-------------------------------------------------------
+    // Name: doubleWithRightChild(avlNode*& k3)
+    // PreCondition:  avlNode k3 passed by reference that has children on both sides
+    // PostCondition: double shifts root k3 and balances its children
+    //---------------------------------------------------------
+    void doubleWithRightChild(avlNode*& k3) {
+        rotateWithLeftChild(k3->right);
+        rotateWithRightChild(k3);
+    }
+
+    // iterator helpers
+
+    //-------------------------------------------------------
+    // Name: successor(const avlNode* n)
+    // PreCondition:  node n given
+    // PostCondition: returns the node after n in order, or nullptr if n holds the maximum
+    //---------------------------------------------------------
+    static const avlNode* successor(const avlNode* n) {
+        if (n->right != nullptr) { // leftmost node of the right subtree
+            n = n->right;
+            while (n->left != nullptr) {
+                n = n->left;
+            }
+            return n;
+        }
+        while (n->parent != nullptr && n->parent->right == n) { // climb out of right subtrees
+            n = n->parent;
+        }
+        return n->parent;
+    }
+
+    //-------------------------------------------------------
+    // Name: predecessor(const avlNode* n)
+    // PreCondition:  node n given
+    // PostCondition: returns the node before n in order, or nullptr if n holds the minimum
+    //---------------------------------------------------------
+    static const avlNode* predecessor(const avlNode* n) {
+        if (n->left != nullptr) { // rightmost node of the left subtree
+            n = n->left;
+            while (n->right != nullptr) {
+                n = n->right;
+            }
+            return n;
+        }
+        while (n->parent != nullptr && n->parent->left == n) { // climb out of left subtrees
+            n = n->parent;
+        }
+        return n->parent;
+    }
+
+    // copy constructor and assignment operator helper
+
+    //-------------------------------------------------------
+    // Name: copyTree(avlNode* p)
+    // PreCondition:  root node p given
+    // PostCondition: Deep copys root node p and children recursively and returns a copy of node p that has a copy of its children
+    //---------------------------------------------------------
+    avlNode* copyTree(avlNode* p) {
+        if (p == nullptr) { // copying an empty tree
+            return nullptr;
+        }
+
+        // copying contents
+        avlNode* c = createNode(p->data);
+        c->height = p->height;
+        c->size = p->size;
+
+        // copying children
+        if (p->left != nullptr) {
+            c->left = copyTree(p->left);
+            c->left->parent = c;
+        }
+        if (p->right != nullptr) {
+            c->right = copyTree(p->right);
+            c->right->parent = c;
+        }
+        return c;
+    }
+
+    // range constructor and assign() helper
+
+    //-------------------------------------------------------
+    // Name: buildTree(RandomIt first, std::size_t n)
+    // PreCondition:  n strictly increasing values starting at first
+    // PostCondition: returns the root of a perfectly balanced tree of the n values with heights set, in O(n)
+    //---------------------------------------------------------
+    template <typename RandomIt>
+    avlNode* buildTree(RandomIt first, std::size_t n) {
+        if (n == 0) {
+            return nullptr;
+        }
+        std::size_t mid = n / 2; // middle value becomes the root
+        avlNode* t = createNode(first[mid]);
+        t->left = buildTree(first, mid);
+        t->right = buildTree(first + mid + 1, n - mid - 1);
+        if (t->left != nullptr) {
+            t->left->parent = t;
+        }
+        if (t->right != nullptr) {
+            t->right->parent = t;
+        }
+        t->height = std::max(height(t->left), height(t->right)) + 1;
+        t->size = n;
+        return t;
+    }
+
+    //-------------------------------------------------------
+    // Name: isStrictlySorted(RandomIt first, RandomIt last)
+    // PreCondition:  range first to last given
+    // PostCondition: returns true if every value is less than the one after it
+    //---------------------------------------------------------
+    template <typename RandomIt>
+    bool isStrictlySorted(RandomIt first, RandomIt last) const {
+        return std::adjacent_find(first, last, [this](const Comparable& a, const Comparable& b) {
+            return !this->comp(a, b);
+        }) == last;
+    }
+
+    // destructor helper
+
+    //-------------------------------------------------------
+    // Name: destroy(avlNode*& p)
+    // PreCondition:  root node p of the tree given
+    // PostCondition: Deletes node p and children, handing the allocator back in whole slabs when it can
+    //---------------------------------------------------------
+    void destroy(avlNode*& p) {
+        if (!NodeAllocator<avlNode>::RELEASES_ALL || !std::is_trivially_destructible<Comparable>::value) {
+            destroyNodes(p);
+        }
+        this->allocator.release();
+        p = nullptr;
+    }
+
+    //-------------------------------------------------------
+    // Name: destroyNodes(avlNode* p)
+    // PreCondition:  node p given
+    // PostCondition: destroys node p and children recursively, freeing them one at a time unless the allocator releases all
+    //---------------------------------------------------------
+    void destroyNodes(avlNode* p) {
+        if (p != nullptr) {
+            destroyNodes(p->left);
+            destroyNodes(p->right);
+            if (NodeAllocator<avlNode>::RELEASES_ALL) {
+                p->~avlNode();
+            }
+            else {
+                destroyNode(p);
+            }
+        }
+    }
+    
+    // helper for balance and rotations
+
+    //-------------------------------------------------------
+    // Name: height(avlNode* t)
+    // PreCondition:  node t given
+    // PostCondition: returns int height of node t
+    //---------------------------------------------------------
+    int height(avlNode* t) {
+        if (t == nullptr) {
+            return -1;
+        }
+        else {
+            return t->height;
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: subtreeSize(const avlNode* t)
+    // PreCondition:  node t given
+    // PostCondition: returns the number of nodes in the subtree of t, 0 for nullptr
+    //---------------------------------------------------------
+    static std::size_t subtreeSize(const avlNode* t) {
+        return (t == nullptr) ? 0 : t->size;
+    }
+
+public:
+    //-------------------------------------------------------
+    // Name: const_iterator
+    // Description: bidirectional in-order iterator over the values of the tree. Steps follow
+    //              parent pointers, so a full scan is amortized O(1) per value and never allocates.
+    //---------------------------------------------------------
+    class const_iterator {
+    private:
+        const avlNode* node; // current node, nullptr once past the end
+        const AVLTree* tree; // tree walked, needed to step back from end()
+
+        const_iterator(const avlNode* node, const AVLTree* tree) : node(node), tree(tree) {}
+        friend class AVLTree;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = Comparable;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Comparable*;
+        using reference = const Comparable&;
+
+        const_iterator() : node(nullptr), tree(nullptr) {}
+
+        reference operator*() const { return this->node->data; }
+        pointer operator->() const { return &this->node->data; }
+
+        const_iterator& operator++() {
+            this->node = successor(this->node);
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++(*this);
+            return old;
+        }
+
+        const_iterator& operator--() {
+            if (this->node == nullptr) { // end() steps back to the maximum
+                const avlNode* n = this->tree->root;
+                while (n->right != nullptr) {
+                    n = n->right;
+                }
+                this->node = n;
+            }
+            else {
+                this->node = predecessor(this->node);
+            }
+            return *this;
+        }
+
+        const_iterator operator--(int) {
+            const_iterator old = *this;
+            --(*this);
+            return old;
+        }
+
+        bool operator==(const const_iterator& rhs) const { return this->node == rhs.node; }
+        bool operator!=(const const_iterator& rhs) const { return this->node != rhs.node; }
+    };
+
+    // values are kept in order by the tree, so they can only be read through an iterator
+    using iterator = const_iterator;
+    using key_compare = Compare;
+
+private:
+    //-------------------------------------------------------
+    // Name: iteratorTo(const avlNode* n)
+    // PreCondition:  node n of the tree, or nullptr for end()
+    // PostCondition: returns an iterator to n
+    //---------------------------------------------------------
+    const_iterator iteratorTo(const avlNode* n) const { return const_iterator(n, this); }
+
+public:
+    // constructors 
+
+    //-------------------------------------------------------
+    // Name: AVLTree()
+    // PreCondition: none
+    // PostCondition: creates new AVLTree object and sets root to nullptr
+    //---------------------------------------------------------
+    AVLTree() {
+        this->root = nullptr;
+    }
+
+    //-------------------------------------------------------
+    // Name: AVLTree(const Compare& comp)
+    // PreCondition: comparator comp given
+    // PostCondition: creates new empty AVLTree that orders its values with comp
+    //---------------------------------------------------------
+    explicit AVLTree(const Compare& comp) : root(nullptr), comp(comp) {}
+
+    //-------------------------------------------------------
+    // Name: AVLTree(const AVLTree& other)
+    // PreCondition: AVLTree other passed by reference
+    // PostCondition: creates new object AVLTree that is a copy of other
+    //---------------------------------------------------------
+    AVLTree(const AVLTree& other) : comp(other.comp), threads(other.threads) {
+        this->root = copyOf(other);
+    }
+
+    //-------------------------------------------------------
+    // Name: AVLTree(AVLTree&& other)
+    // PreCondition: AVLTree other passed as an rvalue
+    // PostCondition: creates new object AVLTree that takes over the nodes of other, leaving other empty.
+    //                Never throws unless copying the comparator can, so containers of trees move them instead of copying.
+    //---------------------------------------------------------
+    AVLTree(AVLTree&& other) noexcept(std::is_nothrow_copy_constructible<Compare>::value)
+        : root(other.root), comp(other.comp), rotations(other.rotations), threads(other.threads) {
+        other.root = nullptr;
+        other.rotations = 0;
+        this->allocator.swap(other.allocator);
+    }
+
+    //-------------------------------------------------------
+    // Name: AVLTree(InputIt first, InputIt last, const Compare& comp = Compare())
+    // PreCondition: range of values first to last given, and a comparator comp if not the default one
+    // PostCondition: creates new AVLTree object holding the values of the range in the order of comp, see assign()
+    //---------------------------------------------------------
+    template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    AVLTree(InputIt first, InputIt last, const Compare& comp = Compare()) : root(nullptr), comp(comp) {
+        assign(first, last);
+    }
+
+    // destructor
+
+    //-------------------------------------------------------
+    // Name: ~AVLTree()
+    // PreCondition: AVLTree object has already been created
+    // PostCondition: destroys all nodes and root of AVLTree object and sets root to nullptr
+    //---------------------------------------------------------
+    ~AVLTree() {
+        destroy(this->root);
+        this->root = nullptr;
+    }
+
+    // assignment operator
+
+    //-------------------------------------------------------
+    // Name: operator=(const AVLTree& other)
+    // PreCondition: AVLTree other passed by reference
+    // PostCondition: return copy of other, having changed this object 
+    //---------------------------------------------------------
+    AVLTree& operator=(const AVLTree& other) {
+        if (this != &other) { // if not same object
+            destroy(this->root);
+            this->comp = other.comp;
+            this->threads = other.threads;
+            this->root = copyOf(other);
+        }
+        return *this;
+    }
+
+    //-------------------------------------------------------
+    // Name: operator=(AVLTree&& other)
+    // PreCondition: AVLTree other passed as an rvalue
+    // PostCondition: frees this tree and takes over the nodes of other, leaving other empty
+    //---------------------------------------------------------
+    AVLTree& operator=(AVLTree&& other) noexcept(std::is_nothrow_copy_assignable<Compare>::value) {
+        if (this != &other) { // if not same object
+            destroy(this->root);
+            std::swap(this->root, other.root);
+            std::swap(this->rotations, other.rotations);
+            this->comp = other.comp;
+            this->threads = other.threads;
+            this->allocator.swap(other.allocator);
+        }
+        return *this;
+    }
+
+    //-------------------------------------------------------
+    // Name: assign(InputIt first, InputIt last)
+    // PreCondition: range of values first to last given
+    // PostCondition: replaces the tree with a perfectly balanced one holding the values of the range.
+    //                Strictly sorted random access input is built in O(n) straight from the range,
+    //                anything else is copied, sorted and deduplicated first.
+    //---------------------------------------------------------
+    template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    void assign(InputIt first, InputIt last) {
+        make_empty();
+        if constexpr (std::is_base_of<std::random_access_iterator_tag,
+                                      typename std::iterator_traits<InputIt>::iterator_category>::value) {
+            if (isStrictlySorted(first, last)) { // no copy needed
+                this->root = buildParallel(first, static_cast<std::size_t>(last - first), forkDepth());
+                return;
+            }
+        }
+
+        std::vector<Comparable> values(first, last);
+        sortUnique(values);
+        this->root = buildParallel(std::make_move_iterator(values.begin()), values.size(), forkDepth());
+    }
+
+    //-------------------------------------------------------
+    // Name: contains(const Comparable& value)
+    // PreCondition: Comparable value passed by reference
+    // PostCondition: return true if value is a node in the tree, false if not
+    //---------------------------------------------------------
+    bool contains(const Comparable& value) const {
+        if (is_empty()) { // empty tree
+            return false;
+        }
+
+        avlNode* current = this->root;
+
+        while (current != nullptr) {
+            int c = three_way(this->comp, value, current->data); // one comparison per level
+            if (c == 0) { // value in tree
+                return true;
+            }
+            else if (c < 0) { // shift left
+                current = current->left;
+            }
+            else { // shift right
+                current = current->right;
+            }
+        }
+
+        // not in tree
+        return false;
+    }
+
+    //-------------------------------------------------------
+    // Name: contains(const Key& key)
+    // PreCondition: key that Compare can compare with the values, only when Compare is transparent like std::less<>
+    // PostCondition: return true if a value equivalent to key is in the tree, without building a Comparable from key,
+    //                so a std::string_view looks up std::string values without a copy
+    //---------------------------------------------------------
+    template <typename Key, typename C = Compare, typename = typename C::is_transparent>
+    bool contains(const Key& key) const {
+        return findNode(key) != nullptr;
+    }
+
+    //-------------------------------------------------------
+    // Name: find(const Comparable& value)
+    // PreCondition: Comparable value passed by reference
+    // PostCondition: returns an iterator to value in the tree, end() if it is not there
+    //---------------------------------------------------------
+    const_iterator find(const Comparable& value) const {
+        return const_iterator(findNode(value), this);
+    }
+
+    //-------------------------------------------------------
+    // Name: find(const Key& key)
+    // PreCondition: key that Compare can compare with the values, only when Compare is transparent like std::less<>
+    // PostCondition: returns an iterator to the value equivalent to key, end() if there is none,
+    //                without building a Comparable from key
+    //---------------------------------------------------------
+    template <typename Key, typename C = Compare, typename = typename C::is_transparent>
+    const_iterator find(const Key& key) const {
+        return const_iterator(findNode(key), this);
+    }
+
+    //-------------------------------------------------------
+    // Name: contains_batch(ForwardIt first, ForwardIt last, OutputIt out)
+    // PreCondition: range of values first to last and where to write one bool per value given. The values
+    //               may be of any default constructible type Compare takes along with Comparable, such as
+    //               std::string_view when Compare is transparent, and are copied as they are looked up.
+    // PostCondition: writes whether each value is in the tree to out, in order, and returns how many were.
+    //                Values are looked up BATCH_PROBES at a time, each walk taking one step per round and
+    //                prefetching the node it steps to, so the cache misses of a whole group overlap
+    //                instead of stalling one after another as separate contains() calls do. Trees of fewer
+    //                than BATCH_PROBE_MIN_SIZE values miss the cache too seldom for that to pay, and are
+    //                searched with contains() instead.
+    //---------------------------------------------------------
+    template <typename ForwardIt, typename OutputIt>
+    std::size_t contains_batch(ForwardIt first, ForwardIt last, OutputIt out) const {
+        using Key = typename std::iterator_traits<ForwardIt>::value_type;
+        std::size_t hits = 0;
+        if (size() < BATCH_PROBE_MIN_SIZE) {
+            for (; first != last; ++first, ++out) {
+                bool found = findNode<Key>(*first) != nullptr;
+                *out = found;
+                hits += found;
+            }
+            return hits;
+        }
+        Key keys[BATCH_PROBES];
+        const avlNode* nodes[BATCH_PROBES]; // where each walk is, nullptr once it has fallen off the tree
+        bool found[BATCH_PROBES];
+        while (first != last) {
+            unsigned group = 0;
+            for (; group < BATCH_PROBES && first != last; ++group, ++first) {
+                keys[group] = *first;
+                nodes[group] = this->root;
+                found[group] = false;
+            }
+            for (bool walking = true; walking;) { // one level of every walk per round
+                walking = false;
+                for (unsigned i = 0; i < group; i++) {
+                    const avlNode* n = nodes[i];
+                    if (n == nullptr) { // this one is done
+                        continue;
+                    }
+                    int c = three_way(this->comp, keys[i], n->data);
+                    if (c < 0) { // shift left
+                        n = n->left;
+                    }
+                    else if (c > 0) { // shift right
+                        n = n->right;
+                    }
+                    else { // value in tree
+                        found[i] = true;
+                        n = nullptr;
+                    }
+                    if (n != nullptr) {
+                        __builtin_prefetch(n); // other walks run while this node loads
+                        walking = true;
+                    }
+                    nodes[i] = n;
+                }
+            }
+            for (unsigned i = 0; i < group; i++) {
+                *out = found[i];
+                ++out;
+                hits += found[i];
+            }
+        }
+        return hits;
+    }
+
+    //-------------------------------------------------------
+    // Name: insert(const Comparable& value)
+    // PreCondition: Comparable value passed by reference
+    // PostCondition: creates a node with value as its data and puts it into tree, balancing it as well.
+    //                Returns an iterator to value in the tree and whether it was inserted, in one walk down.
+    //---------------------------------------------------------
+    std::pair<const_iterator, bool> insert(const Comparable& value) {
+        avlNode* parent;
+        avlNode** link = findSlot(value, parent);
+        return {const_iterator(insertAt(link, parent, value), this), link != nullptr};
+    }
+
+    //-------------------------------------------------------
+    // Name: insert(Comparable&& value)
+    // PreCondition: Comparable value passed as an rvalue
+    // PostCondition: moves value into a new node and puts it into tree, balancing it as well.
+    //                Returns an iterator to value in the tree and whether it was inserted.
+    //---------------------------------------------------------
+    std::pair<const_iterator, bool> insert(Comparable&& value) {
+        avlNode* parent;
+        avlNode** link = findSlot(value, parent);
+        return {const_iterator(insertAt(link, parent, std::move(value)), this), link != nullptr};
+    }
+
+    //-------------------------------------------------------
+    // Name: insert(const_iterator hint, const Comparable& value)
+    // PreCondition: iterator hint to the value that will follow value, or end() if value goes last
+    // PostCondition: inserts value like insert(value) and returns an iterator to it. With a correct hint
+    //                the walk down from the root is skipped, so inserting sorted values at end() costs
+    //                amortized O(1) comparisons before rebalancing.
+    //---------------------------------------------------------
+    const_iterator insert(const_iterator hint, const Comparable& value) {
+        avlNode* parent;
+        avlNode** link = hintSlot(hint.node, value, parent);
+        return const_iterator(insertAt(link, parent, value), this);
+    }
+
+    //-------------------------------------------------------
+    // Name: insert(const_iterator hint, Comparable&& value)
+    // PreCondition: iterator hint to the value that will follow value, or end() if value goes last
+    // PostCondition: moves value into the tree like insert(hint, const Comparable&) and returns an iterator to it
+    //---------------------------------------------------------
+    const_iterator insert(const_iterator hint, Comparable&& value) {
+        avlNode* parent;
+        avlNode** link = hintSlot(hint.node, value, parent);
+        return const_iterator(insertAt(link, parent, std::move(value)), this);
+    }
+
+    //-------------------------------------------------------
+    // Name: emplace(Args&&... args)
+    // PreCondition: arguments for a Comparable constructor given
+    // PostCondition: builds the value in place inside a new node and puts it into tree, balancing it as well.
+    //                The node is freed again if an equal value is already there.
+    //                Returns an iterator to the value in the tree and whether it was inserted.
+    //---------------------------------------------------------
+    template <typename... Args>
+    std::pair<const_iterator, bool> emplace(Args&&... args) {
+        avlNode* n = createNode(std::forward<Args>(args)...);
+        avlNode* parent;
+        avlNode** link = findSlot(n->data, parent);
+        if (link == nullptr) { // already in tree, parent holds it
+            destroyNode(n);
+            return {const_iterator(parent, this), false};
+        }
+        attach(n, parent, link);
+        return {const_iterator(n, this), true};
+    }
+
+    //-------------------------------------------------------
+    // Name: remove(const Comparable& value)
+    // PreCondition: Comparable value passed by reference
+    // PostCondition: remove a node with value and balances the tree
+    //---------------------------------------------------------
+    void remove(const Comparable& value) {
+        removeKey(value);
+    }
+
+    //-------------------------------------------------------
+    // Name: insert_batch(InputIt first, InputIt last)
+    // PreCondition: range of values first to last given
+    // PostCondition: inserts every value of the range not in the tree yet and returns how many went in.
+    //                The batch is sorted once, then split around the tree and joined back in,
+    //                O(m log(n / m + 1)). Merging and rebuilding the whole tree in one O(n + m) pass never
+    //                measured faster, at any batch size, so inserts always join.
+    //---------------------------------------------------------
+    template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    std::size_t insert_batch(InputIt first, InputIt last) {
+        std::vector<Comparable> values = sortedBatch(first, last);
+        if (values.empty()) {
+            return 0;
+        }
+        std::size_t before = size();
+        this->root = unionSorted(this->root, values.data(), values.data() + values.size());
+        return size() - before;
+    }
+
+    //-------------------------------------------------------
+    // Name: remove_batch(InputIt first, InputIt last)
+    // PreCondition: range of values first to last given
+    // PostCondition: removes every value of the range that is in the tree and returns how many were removed.
+    //                The batch is split around the tree like in insert_batch(), but batches of at least
+    //                REMOVE_REBUILD_FACTOR times size() values instead filter the tree in order and rebuild it in
+    //                one O(n + m) pass, which measured as fast or faster from there on, see the remove_batch_x rows
+    //                of make bench.
+    //---------------------------------------------------------
+    template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    std::size_t remove_batch(InputIt first, InputIt last) {
+        std::vector<Comparable> values = sortedBatch(first, last);
+        if (values.empty() || is_empty()) {
+            return 0;
+        }
+        std::size_t before = size();
+        if (values.size() >= REMOVE_REBUILD_FACTOR * before) {
+            filterRebuild(values);
+        }
+        else {
+            this->root = differenceSorted(this->root, values.data(), values.data() + values.size());
+        }
+        return before - size();
+    }
+
+    //-------------------------------------------------------
+    // Name: split(const Comparable& key)
+    // PreCondition: Comparable key passed by reference
+    // PostCondition: keeps the values less than key and returns a tree holding the rest, O(log n), ordered by
+    //                the same comparator and with the same parallelism. No nodes are copied: both trees
+    //                share this tree's storage from then on.
+    //---------------------------------------------------------
+    AVLTree split(const Comparable& key) {
+        AVLTree right(this->comp);
+        right.threads = this->threads;
+        right.allocator.share(this->allocator);
+        avlNode* l;
+        avlNode* r;
+        avlNode* found = splitNodes(this->root, key, l, r);
+        if (found != nullptr) { // key goes with the greater values
+            r = joinNodes(nullptr, found, r);
+        }
+        this->root = l;
+        right.root = r;
+        return right;
+    }
+
+    //-------------------------------------------------------
+    // Name: join(AVLTree&& left, const Comparable& key, AVLTree&& right)
+    // PreCondition: trees left and right passed as rvalues, every value in left less than key and every value in right greater
+    // PostCondition: returns a tree holding left, key and right, taking over their nodes in O(log n),
+    //                throws std::invalid_argument if the values are not in that order
+    //---------------------------------------------------------
+    static AVLTree join(AVLTree&& left, const Comparable& key, AVLTree&& right) {
+        if ((!left.is_empty() && !left.comp(left.find_max(), key)) || (!right.is_empty() && !right.comp(key, right.find_min()))) {
+            throw std::invalid_argument("Trees are not ordered around key");
+        }
+        AVLTree joined(std::move(left));
+        avlNode* r = joined.takeNodes(right);
+        joined.root = joined.joinNodes(joined.root, joined.createNode(key), r);
+        return joined;
+    }
+
+    //-------------------------------------------------------
+    // Name: union_with(const AVLTree& other)
+    // PreCondition: AVLTree other passed by reference
+    // PostCondition: adds the values of other to this tree. other is copied, then merged in
+    //                O(m log(n / m + 1)) for trees of m and n values with m <= n.
+    //                Both steps use up to parallelism() threads.
+    //---------------------------------------------------------
+    void union_with(const AVLTree& other) {
+        if (this != &other) {
+            this->root = unionParallel(this->root, copyOf(other), forkDepth());
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: union_with(AVLTree&& other)
+    // PreCondition: AVLTree other passed as an rvalue
+    // PostCondition: adds the values of other to this tree, taking over other's nodes, leaving other empty
+    //---------------------------------------------------------
+    void union_with(AVLTree&& other) {
+        if (this != &other) {
+            this->root = unionParallel(this->root, takeNodes(other), forkDepth());
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: intersect_with(const AVLTree& other)
+    // PreCondition: AVLTree other passed by reference
+    // PostCondition: keeps only the values also in other, O(m log(n / m + 1)) after copying other
+    //---------------------------------------------------------
+    void intersect_with(const AVLTree& other) {
+        if (this != &other) {
+            this->root = intersectParallel(this->root, copyOf(other), forkDepth());
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: intersect_with(AVLTree&& other)
+    // PreCondition: AVLTree other passed as an rvalue
+    // PostCondition: keeps only the values also in other, using up other's nodes, leaving other empty
+    //---------------------------------------------------------
+    void intersect_with(AVLTree&& other) {
+        if (this != &other) {
+            this->root = intersectParallel(this->root, takeNodes(other), forkDepth());
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: difference_with(const AVLTree& other)
+    // PreCondition: AVLTree other passed by reference
+    // PostCondition: removes the values that are in other, O(m log(n / m + 1)) after copying other
+    //---------------------------------------------------------
+    void difference_with(const AVLTree& other) {
+        if (this == &other) {
+            make_empty();
+        }
+        else {
+            this->root = differenceParallel(this->root, copyOf(other), forkDepth());
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: difference_with(AVLTree&& other)
+    // PreCondition: AVLTree other passed as an rvalue
+    // PostCondition: removes the values that are in other, using up other's nodes, leaving other empty
+    //---------------------------------------------------------
+    void difference_with(AVLTree&& other) {
+        if (this == &other) {
+            make_empty();
+        }
+        else {
+            this->root = differenceParallel(this->root, takeNodes(other), forkDepth());
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: find_min()
+    // PreCondition: root is not a nullptr
+    // PostCondition: returns the Comparable data of the minimum value node in the tree
+    //---------------------------------------------------------
+    const Comparable& find_min() const {
+        if (this->root == nullptr) {
+            throw std::invalid_argument("AVLTree is empty");
+        }
+
+        avlNode* current = this->root;
+        while (current->left != nullptr) { // get to leftmost node
+            current = current->left;
+        }
+        return current->data;
+    }
+
+    //-------------------------------------------------------
+    // Name: find_max()
+    // PreCondition: root is not a nullptr
+    // PostCondition: returns the data of the maximum value node in the tree
+    //---------------------------------------------------------
+    const Comparable& find_max() const {
+        if (this->root == nullptr) {
+            throw std::invalid_argument("AVLTree is empty");
+        }
+        avlNode* current = this->root;
+        while (current->right != nullptr) { // get to rightmost node
+            current = current->right;
+        }
+        return current->data;
+    }
+
+    //-------------------------------------------------------
+    // Name: begin()
+    // PreCondition: none
+    // PostCondition: returns an iterator to the minimum value, or end() if the tree is empty
+    //---------------------------------------------------------
+    const_iterator begin() const {
+        const avlNode* current = this->root;
+        if (current != nullptr) {
+            while (current->left != nullptr) { // get to leftmost node
+                current = current->left;
+            }
+        }
+        return const_iterator(current, this);
+    }
+
+    //-------------------------------------------------------
+    // Name: end()
+    // PreCondition: none
+    // PostCondition: returns the iterator one past the maximum value
+    //---------------------------------------------------------
+    const_iterator end() const { return const_iterator(nullptr, this); }
+
+    //-------------------------------------------------------
+    // Name: lower_bound(const Comparable& value)
+    // PreCondition: Comparable value passed by reference
+    // PostCondition: returns an iterator to the first value not less than value, or end()
+    //---------------------------------------------------------
+    const_iterator lower_bound(const Comparable& value) const {
+        const avlNode* found = nullptr;
+        const avlNode* current = this->root;
+        while (current != nullptr) {
+            if (this->comp(current->data, value)) { // too small, shift right
+                current = current->right;
+            }
+            else { // candidate, look for a smaller one on the left
+                found = current;
+                current = current->left;
+            }
+        }
+        return const_iterator(found, this);
+    }
+
+    //-------------------------------------------------------
+    // Name: upper_bound(const Comparable& value)
+    // PreCondition: Comparable value passed by reference
+    // PostCondition: returns an iterator to the first value greater than value, or end()
+    //---------------------------------------------------------
+    const_iterator upper_bound(const Comparable& value) const {
+        const avlNode* found = nullptr;
+        const avlNode* current = this->root;
+        while (current != nullptr) {
+            if (this->comp(value, current->data)) { // candidate, look for a smaller one on the left
+                found = current;
+                current = current->left;
+            }
+            else { // too small, shift right
+                current = current->right;
+            }
+        }
+        return const_iterator(found, this);
+    }
+
+    // order statistics, kept in O(log n) by the subtree size stored in every node
+
+    //-------------------------------------------------------
+    // Name: size()
+    // PreCondition: none
+    // PostCondition: returns the number of values in the tree
+    //---------------------------------------------------------
+    std::size_t size() const { return subtreeSize(this->root); }
+
+    //-------------------------------------------------------
+    // Name: rank(const Comparable& value)
+    // PreCondition: Comparable value passed by reference
+    // PostCondition: returns how many values in the tree are less than value
+    //---------------------------------------------------------
+    std::size_t rank(const Comparable& value) const {
+        std::size_t less = 0;
+        const avlNode* current = this->root;
+        while (current != nullptr) {
+            if (this->comp(current->data, value)) { // current and its left subtree are all smaller
+                less += subtreeSize(current->left) + 1;
+                current = current->right;
+            }
+            else {
+                current = current->left;
+            }
+        }
+        return less;
+    }
+
+    //-------------------------------------------------------
+    // Name: select(std::size_t k)
+    // PreCondition: k is less than size()
+    // PostCondition: returns the k-th smallest value, counting from 0
+    //---------------------------------------------------------
+    const Comparable& select(std::size_t k) const {
+        if (k >= size()) {
+            throw std::out_of_range("AVLTree select index out of range");
+        }
+        const avlNode* current = this->root;
+        while (true) {
+            std::size_t leftSize = subtreeSize(current->left);
+            if (k < leftSize) { // in left subtree
+                current = current->left;
+            }
+            else if (k > leftSize) { // in right subtree, skip the left subtree and current
+                k -= leftSize + 1;
+                current = current->right;
+            }
+            else {
+                return current->data;
+            }
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: count_range(const Comparable& lo, const Comparable& hi)
+    // PreCondition: Comparable lo and hi passed by reference
+    // PostCondition: returns how many values are in [lo, hi)
+    //---------------------------------------------------------
+    std::size_t count_range(const Comparable& lo, const Comparable& hi) const {
+        if (!this->comp(lo, hi)) {
+            return 0;
+        }
+        return rank(hi) - rank(lo);
+    }
+
+    //-------------------------------------------------------
+    // Name: for_each_in_range(const Comparable& lo, const Comparable& hi, Function fn)
+    // PreCondition: Comparable lo and hi passed by reference, fn callable with a const Comparable&
+    // PostCondition: calls fn on every value in [lo, hi) in order
+    //---------------------------------------------------------
+    template <typename Function>
+    void for_each_in_range(const Comparable& lo, const Comparable& hi, Function fn) const {
+        for (const_iterator it = lower_bound(lo); it != end() && this->comp(*it, hi); ++it) {
+            fn(*it);
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: freeze()
+    // PreCondition: none
+    // PostCondition: returns a read-only copy of the values laid out in one array for fast searches, see frozen_tree.h
+    //---------------------------------------------------------
+    FrozenTree<Comparable, Compare> freeze() const {
+        return FrozenTree<Comparable, Compare>(begin(), end(), this->comp);
+    }
+
+    //-------------------------------------------------------
+    // Name: save(const std::string& path)
+    // PreCondition: path of the file to write, Comparable trivially copyable
+    // PostCondition: writes the values in order to path as a tree file for load() or MappedTree, see tree_file.h.
+    //                Throws std::runtime_error if the file cannot be written.
+    //---------------------------------------------------------
+    void save(const std::string& path) const {
+        write_tree_file<Comparable>(path, begin(), size());
+    }
+
+    //-------------------------------------------------------
+    // Name: load(const std::string& path)
+    // PreCondition: path of a tree file of Comparable values, saved in the order of this tree's comparator
+    // PostCondition: replaces the tree with a perfectly balanced one holding the saved values, built in O(n)
+    //                with no comparisons besides checking the order. Throws std::runtime_error and leaves
+    //                the tree as it was if the file cannot be read.
+    //---------------------------------------------------------
+    void load(const std::string& path) {
+        std::vector<Comparable> values = read_tree_file<Comparable>(path);
+        assign(values.begin(), values.end());
+    }
+
+    //-------------------------------------------------------
+    // Name: print_tree(std::ostream& os=std::cout)
+    // PreCondition: ostream os defaults to cout if none given
+    // PostCondition: prints 90 degree rotated tree to os
+    //---------------------------------------------------------
+    void print_tree(std::ostream& os=std::cout) const {
+        if (!is_empty()) {
+            write_tree(os, this->root, TreeFormat::Rotated, NO_DEPTH_LIMIT);
+        }
+        else { // empty tree
+            os << "<empty>\n";
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: export_tree(std::ostream& os, TreeFormat format, std::size_t max_depth = NO_DEPTH_LIMIT)
+    // PreCondition: ostream os, format to write in, and the deepest level to write, the root being at 0
+    // PostCondition: writes the tree to os as Graphviz DOT, JSON, one line per level or rotated like print_tree(),
+    //                leaving out nodes deeper than max_depth, see tree_print.h
+    //---------------------------------------------------------
+    void export_tree(std::ostream& os, TreeFormat format, std::size_t max_depth = NO_DEPTH_LIMIT) const {
+        write_tree(os, this->root, format, max_depth);
+    }
+
+    //-------------------------------------------------------
+    // Name: is_empty()
+    // PreCondition: none
+    // PostCondition: returns true if tree is empty, false if it isnt
+    //---------------------------------------------------------
+    bool is_empty() const { return (this->root == nullptr); }
+
+    //-------------------------------------------------------
+    // Name: set_parallelism(unsigned n)
+    // PreCondition: number of threads n given, 0 meaning one per hardware thread
+    // PostCondition: lets bulk operations use up to n threads: assign(), copying and the set operations. They fork on independent subtrees and stay on the calling thread
+    //                below PARALLEL_GRAIN nodes. 1, the default, never starts a thread. Copies keep the setting.
+    //---------------------------------------------------------
+    void set_parallelism(unsigned n) {
+        if (n == 0) {
+            n = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+        this->threads = n;
+    }
+
+    //-------------------------------------------------------
+    // Name: parallelism()
+    // PreCondition: none
+    // PostCondition: returns the most threads bulk operations may use, see set_parallelism()
+    //---------------------------------------------------------
+    unsigned parallelism() const {
+        return this->threads;
+    }
+
+    //-------------------------------------------------------
+    // Name: key_comp()
+    // PreCondition: none
+    // PostCondition: returns the comparator that orders the values
+    //---------------------------------------------------------
+    Compare key_comp() const { return this->comp; }
+
+    //-------------------------------------------------------
+    // Name: rotation_count()
+    // PreCondition: none
+    // PostCondition: returns how many single rotations inserts and removes have done, a double rotation counts as two
+    //---------------------------------------------------------
+    std::size_t rotation_count() const { return this->rotations; }
+
+    //-------------------------------------------------------
+    // Name: make_empty()
+    // PreCondition: none
+    // PostCondition: destroys all nodes, including root of tree, making it empyu.
+    //---------------------------------------------------------
+    void make_empty() { 
+        destroy(this->root); 
+        this->root = nullptr;
+    }
 };
 
 #endif
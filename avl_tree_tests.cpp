@@ -7,7 +7,17 @@
 ** E-mail:  naimurrah01@tamu.edu
 ** Description: Tests for AVLTree Class
 **/
+#include <algorithm>
+#include <cstdio>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
 #include "avl_tree.h"
 
 using std::cout, std::endl;
@@ -172,5 +182,552 @@ int main() {
     cbst.print_tree();
     cout << "Min val: should be a: " << cbst.find_min() << endl;
     cout << "Max val: should be z: " << cbst.find_max() << endl;
+    cout << endl;
+
+    // allocator tests
+    AVLTree<int, HeapAllocator> heap;
+    for (int i = 0; i < 100; i++) {
+        heap.insert((i * 37) % 100);
+    }
+    for (int i = 0; i < 100; i += 2) {
+        heap.remove(i);
+    }
+    cout << "Heap allocator min: should be 1: " << heap.find_min() << endl;
+    cout << "Heap allocator max: should be 99: " << heap.find_max() << endl;
+    cout << "Heap allocator contains 50: should be 0: " << heap.contains(50) << endl;
+
+    AVLTree<int> pooled;
+    for (int i = 0; i < 1000; i++) {
+        pooled.insert((i * 7919) % 1000);
+    }
+    for (int i = 0; i < 1000; i += 3) { // freed nodes go back on the free list
+        pooled.remove(i);
+    }
+    for (int i = 0; i < 1000; i += 3) { // and come back off it
+        pooled.insert(i);
+    }
+    cout << "Pool min: should be 0: " << pooled.find_min() << endl;
+    cout << "Pool max: should be 999: " << pooled.find_max() << endl;
+    cout << "Pool contains 333: should be 1: " << pooled.contains(333) << endl;
+    pooled.make_empty();
+    cout << "Pool empty after make_empty: should be 1: " << pooled.is_empty() << endl;
+    pooled.insert(5);
+    cout << "Pool reused after make_empty, min: should be 5: " << pooled.find_min() << endl;
+
+    AVLTree<std::string> strings; // keys that need their destructors run
+    strings.insert("pear");
+    strings.insert("apple");
+    strings.insert("fig");
+    strings.remove("pear");
+    AVLTree<std::string> stringsCopy(strings);
+    strings.make_empty();
+    cout << "String copy min: should be apple: " << stringsCopy.find_min() << endl;
+    cout << "String copy max: should be fig: " << stringsCopy.find_max() << endl;
+    cout << endl;
+
+    // range constructor tests
+    std::vector<int> sorted = {1, 2, 3, 4, 5, 6, 7};
+    AVLTree<int> built(sorted.begin(), sorted.end());
+    cout << "Built from sorted 1..7, balanced with 4 as root:" << endl;
+    built.print_tree();
+    cout << "Built min: should be 1: " << built.find_min() << endl;
+    cout << "Built max: should be 7: " << built.find_max() << endl;
+
+    std::vector<int> unsorted = {5, 3, 9, 3, 1, 7, 5};
+    built.assign(unsorted.begin(), unsorted.end());
+    cout << "Assigned from unsorted with duplicates, holds 1 3 5 7 9:" << endl;
+    built.print_tree();
+    cout << "Built contains 4: should be 0: " << built.contains(4) << endl;
+    cout << "Built contains 9: should be 1: " << built.contains(9) << endl;
+
+    built.assign(sorted.begin(), sorted.begin());
+    cout << "Assigned from empty range, empty: should be 1: " << built.is_empty() << endl;
+    cout << endl;
+
+    // iterative insert/remove tests
+    AVLTree<int> rot;
+    rot.insert(1);
+    rot.insert(2);
+    rot.insert(3);
+    cout << "Rotations after inserting 1, 2, 3: should be 1: " << rot.rotation_count() << endl;
+    rot.insert(4);
+    cout << "Rotations after inserting 4: should be 1: " << rot.rotation_count() << endl;
+    rot.insert(5);
+    cout << "Rotations after inserting 5: should be 2: " << rot.rotation_count() << endl;
+    rot.print_tree();
+
+    AVLTree<int> big;
+    for (int i = 0; i < 10000; i++) {
+        big.insert((i * 7919) % 10000);
+    }
+    for (int i = 0; i < 10000; i++) {
+        if (i % 5 != 0) {
+            big.remove((i * 7919) % 10000);
+        }
+    }
+    int missing = 0;
+    for (int i = 0; i < 10000; i++) {
+        if (big.contains(i) != (i % 5 == 0)) {
+            missing++;
+        }
+    }
+    cout << "Wrong answers after 10000 inserts and 8000 removes: should be 0: " << missing << endl;
+    cout << "Min after removes: should be 0: " << big.find_min() << endl;
+    cout << "Max after removes: should be 9995: " << big.find_max() << endl;
+    cout << endl;
+
+    // iterator tests
+    AVLTree<int> ordered;
+    for (int v : {50, 20, 80, 10, 30, 70, 90, 60}) {
+        ordered.insert(v);
+    }
+    cout << "In order: should be 10 20 30 50 60 70 80 90: ";
+    for (int v : ordered) {
+        cout << v << ' ';
+    }
+    cout << endl;
+    cout << "Reverse: should be 90 80 70 60 50 30 20 10: ";
+    for (AVLTree<int>::const_iterator it = ordered.end(); it != ordered.begin();) {
+        --it;
+        cout << *it << ' ';
+    }
+    cout << endl;
+    cout << "lower_bound(55): should be 60: " << *ordered.lower_bound(55) << endl;
+    cout << "lower_bound(60): should be 60: " << *ordered.lower_bound(60) << endl;
+    cout << "upper_bound(60): should be 70: " << *ordered.upper_bound(60) << endl;
+    cout << "upper_bound(90) is end: should be 1: " << (ordered.upper_bound(90) == ordered.end()) << endl;
+    cout << "lower_bound(5) is begin: should be 1: " << (ordered.lower_bound(5) == ordered.begin()) << endl;
+    ordered.remove(50);
+    cout << "In order after removing 50: should be 10 20 30 60 70 80 90: ";
+    for (AVLTree<int>::const_iterator it = ordered.begin(); it != ordered.end(); it++) {
+        cout << *it << ' ';
+    }
+    cout << endl;
+    AVLTree<int> none;
+    cout << "Empty tree begin is end: should be 1: " << (none.begin() == none.end()) << endl;
+    cout << endl;
+
+    // order statistics tests
+    AVLTree<int> stats;
+    for (int i = 1; i <= 100; i++) {
+        stats.insert(i * 10); // 10, 20, ..., 1000
+    }
+    stats.remove(500);
+    cout << "Size: should be 99: " << stats.size() << endl;
+    cout << "Rank of 10: should be 0: " << stats.rank(10) << endl;
+    cout << "Rank of 255: should be 25: " << stats.rank(255) << endl;
+    cout << "Rank of 2000: should be 99: " << stats.rank(2000) << endl;
+    cout << "Select 0: should be 10: " << stats.select(0) << endl;
+    cout << "Select 49: should be 510: " << stats.select(49) << endl;
+    cout << "Select 98: should be 1000: " << stats.select(98) << endl;
+    try {
+        stats.select(99);
+    }
+    catch (const std::out_of_range&) {
+        cout << "Invalid select test success" << endl;
+    }
+    cout << "Count in [100, 200): should be 10: " << stats.count_range(100, 200) << endl;
+    cout << "Count in [450, 560): should be 10: " << stats.count_range(450, 560) << endl;
+    cout << "Count in [200, 100): should be 0: " << stats.count_range(200, 100) << endl;
+    int rangeSum = 0;
+    stats.for_each_in_range(480, 530, [&rangeSum](int v) { rangeSum += v; });
+    cout << "Sum of [480, 530): should be 2000: " << rangeSum << endl;
+    cout << endl;
+
+    // move and emplace tests
+    AVLTree<std::string> words;
+    std::string pear = "pear";
+    words.insert(std::move(pear));
+    words.emplace(5, 'z'); // "zzzzz" built inside the node
+    words.emplace("apple");
+    words.emplace("pear"); // already there
+    cout << "Words min: should be apple: " << words.find_min() << endl;
+    cout << "Words max: should be zzzzz: " << words.find_max() << endl;
+    cout << "Contains pear: should be 1: " << words.contains("pear") << endl;
+
+    AVLTree<std::string> moved(std::move(words));
+    cout << "Moved from tree empty: should be 1: " << words.is_empty() << endl;
+    cout << "Moved to tree min: should be apple: " << moved.find_min() << endl;
+    words.insert("reused");
+    cout << "Moved from tree reused, min: should be reused: " << words.find_min() << endl;
+
+    words = std::move(moved);
+    cout << "Move assigned tree min: should be apple: " << words.find_min() << endl;
+    cout << "Move assigned from tree empty: should be 1: " << moved.is_empty() << endl;
+    static_assert(std::is_nothrow_move_constructible<AVLTree<int>>::value, "containers of trees move them");
+    static_assert(std::is_nothrow_move_assignable<AVLTree<int>>::value, "containers of trees move them");
+    std::vector<AVLTree<std::string>> forest(1);
+    forest[0].insert("kept");
+    const std::string* kept = &*forest[0].begin();
+    for (int i = 0; i < 100; i++) { // reallocates a few times
+        forest.emplace_back();
+    }
+    cout << "Tree moved, not copied, when a vector grows: should be 1: " << (&*forest[0].begin() == kept) << endl;
+    cout << endl;
+
+    // insert result and hint tests
+    AVLTree<int> hinted;
+    std::pair<AVLTree<int>::iterator, bool> result = hinted.insert(20);
+    cout << "First insert inserted: should be 1: " << result.second << endl;
+    cout << "First insert iterator: should be 20: " << *result.first << endl;
+    result = hinted.insert(20);
+    cout << "Duplicate insert inserted: should be 0: " << result.second << endl;
+    cout << "Duplicate insert iterator: should be 20: " << *result.first << endl;
+    result = hinted.emplace(10);
+    cout << "Emplace inserted: should be 1: " << result.second << endl;
+    for (int i = 30; i <= 60; i += 10) { // sorted input, the end is always the right hint
+        hinted.insert(hinted.end(), i);
+    }
+    AVLTree<int>::iterator at = hinted.insert(hinted.lower_bound(40), 35);
+    cout << "Hinted insert iterator: should be 35: " << *at << endl;
+    at = hinted.insert(hinted.begin(), 55); // wrong hint still inserts
+    cout << "Wrong hint iterator: should be 55: " << *at << endl;
+    at = hinted.insert(hinted.end(), 30); // already there
+    cout << "Duplicate hint iterator: should be 30: " << *at << endl;
+    cout << "In order: should be 10 20 30 35 40 50 55 60: ";
+    for (int v : hinted) {
+        cout << v << ' ';
+    }
+    cout << endl;
+    cout << "Size: should be 8: " << hinted.size() << endl;
+    cout << endl;
+
+    // batch tests
+    AVLTree<int> batched;
+    std::vector<int> firstBatch = {40, 10, 30, 20, 10, 50};
+    cout << "Batch inserted into empty tree: should be 5: " << batched.insert_batch(firstBatch.begin(), firstBatch.end()) << endl;
+    std::vector<int> secondBatch = {25, 5, 30, 55};
+    cout << "Batch inserted: should be 3: " << batched.insert_batch(secondBatch.begin(), secondBatch.end()) << endl;
+    cout << "In order: should be 5 10 20 25 30 40 50 55: ";
+    for (int v : batched) {
+        cout << v << ' ';
+    }
+    cout << endl;
+    std::vector<int> removeBatch = {10, 99, 40, 55};
+    cout << "Batch removed: should be 3: " << batched.remove_batch(removeBatch.begin(), removeBatch.end()) << endl;
+    cout << "In order: should be 5 20 25 30 50: ";
+    for (int v : batched) {
+        cout << v << ' ';
+    }
+    cout << endl;
+    batched.print_tree();
+    std::vector<int> bigBatch;
+    for (int i = 0; i < 1000; i++) {
+        bigBatch.push_back((i * 7) % 1000);
+    }
+    batched.insert_batch(bigBatch.begin(), bigBatch.end());
+    cout << "Size after big batch: should be 1000: " << batched.size() << endl;
+    cout << "Rank of 500: should be 500: " << batched.rank(500) << endl;
+    batched.remove_batch(bigBatch.begin(), bigBatch.begin() + 990);
+    cout << "Size after removing most: should be 10: " << batched.size() << endl;
+    cout << endl;
+
+    // split, join and set operation tests
+    std::vector<int> evens = {2, 4, 6, 8, 10, 12};
+    AVLTree<int> low(evens.begin(), evens.end());
+    AVLTree<int> high = low.split(7);
+    cout << "Split low: should be 2 4 6: ";
+    for (int v : low) {
+        cout << v << ' ';
+    }
+    cout << endl;
+    cout << "Split high: should be 8 10 12: ";
+    for (int v : high) {
+        cout << v << ' ';
+    }
+    cout << endl;
+    AVLTree<int> keyed = high.split(10);
+    cout << "Split at a value keeps it on the right, min: should be 10: " << keyed.find_min() << endl;
+    AVLTree<int> joined = AVLTree<int>::join(std::move(low), 7, std::move(high));
+    cout << "Joined: should be 2 4 6 7 8: ";
+    for (int v : joined) {
+        cout << v << ' ';
+    }
+    cout << endl;
+    cout << "Joined from trees empty: should be 1: " << (low.is_empty() && high.is_empty()) << endl;
+    try {
+        AVLTree<int>::join(std::move(joined), 3, std::move(keyed));
+        cout << "Join out of order: should be thrown: not thrown" << endl;
+    }
+    catch (std::invalid_argument& e) {
+        cout << "Join out of order: should be thrown: thrown" << endl;
+    }
+    // halves of a split tree share its storage, but each inserts into storage of its own
+    AVLTree<int> lower;
+    for (int i = 0; i < 20000; i += 2) {
+        lower.insert(i);
+    }
+    AVLTree<int> upper = lower.split(10000);
+    std::thread lowerInserts([&lower] {
+        for (int i = 1; i < 10000; i += 2) {
+            lower.insert(i);
+        }
+    });
+    std::thread upperInserts([&upper] {
+        for (int i = 10001; i < 20000; i += 2) {
+            upper.insert(i);
+        }
+    });
+    lowerInserts.join();
+    upperInserts.join();
+    int lost = 0;
+    for (int i = 0; i < 20000; i++) {
+        lost += !(i < 10000 ? lower.contains(i) : upper.contains(i));
+    }
+    cout << "Inserts into both halves on two threads, missing: should be 0: " << lost << endl;
+    lower.make_empty();
+    cout << "Upper after lower emptied, size: should be 10000: " << upper.size() << endl;
+    cout << "Upper after lower emptied, max: should be 19999: " << upper.find_max() << endl;
+
+    std::vector<int> firstSet = {1, 3, 5, 7, 9};
+    std::vector<int> secondSet = {3, 4, 5, 6};
+    AVLTree<int> unioned(firstSet.begin(), firstSet.end());
+    AVLTree<int> other(secondSet.begin(), secondSet.end());
+    unioned.union_with(other);
+    cout << "Union: should be 1 3 4 5 6 7 9: ";
+    for (int v : unioned) {
+        cout << v << ' ';
+    }
+    cout << endl;
+    AVLTree<int> intersected(firstSet.begin(), firstSet.end());
+    intersected.intersect_with(other);
+    cout << "Intersection: should be 3 5: ";
+    for (int v : intersected) {
+        cout << v << ' ';
+    }
+    cout << endl;
+    AVLTree<int> differenced(firstSet.begin(), firstSet.end());
+    differenced.difference_with(std::move(other));
+    cout << "Difference: should be 1 7 9: ";
+    for (int v : differenced) {
+        cout << v << ' ';
+    }
+    cout << endl;
+    cout << "Moved set operand empty: should be 1: " << other.is_empty() << endl;
+    cout << endl;
+
+    // parallel tests
+    AVLTree<int> wide;
+    wide.set_parallelism(4);
+    cout << "Parallelism: should be 4: " << wide.parallelism() << endl;
+    std::vector<int> manyValues;
+    for (int i = 0; i < 100000; i++) {
+        manyValues.push_back(2 * i);
+    }
+    wide.assign(manyValues.begin(), manyValues.end()); // big enough to be built on several threads
+    cout << "Built in parallel, size: should be 100000: " << wide.size() << endl;
+    cout << "Built in parallel, select(1234): should be 2468: " << wide.select(1234) << endl;
+    AVLTree<int> wideCopy(wide);
+    cout << "Copy keeps parallelism: should be 4: " << wideCopy.parallelism() << endl;
+    AVLTree<int> odds;
+    for (int i = 0; i < 100000; i++) {
+        odds.insert(2 * i + 1);
+    }
+    wideCopy.union_with(odds);
+    cout << "Parallel union size: should be 200000: " << wideCopy.size() << endl;
+    cout << "Parallel union rank(1001): should be 1001: " << wideCopy.rank(1001) << endl;
+    wideCopy.difference_with(wide);
+    cout << "Parallel difference min: should be 1: " << wideCopy.find_min() << endl;
+    wideCopy.intersect_with(odds);
+    cout << "Parallel intersection size: should be 100000: " << wideCopy.size() << endl;
+    cout << endl;
+
+    // batched lookup tests
+    std::vector<int> lookups = {4, 5, 0, 199998, 199999, -2, 2468};
+    std::vector<bool> answers;
+    cout << "Batch found in small tree: should be 4: "
+         << wide.contains_batch(lookups.begin(), lookups.end(), std::back_inserter(answers)) << endl;
+    cout << "Batch answers: should be 1 0 1 1 0 0 1: ";
+    for (bool a : answers) {
+        cout << a << ' ';
+    }
+    cout << endl;
+    AVLTree<int> tall; // big enough for the lookups to walk down side by side
+    for (int i = 0; i < 300000; i++) {
+        tall.insert(static_cast<int>(i * 7919LL % 300000) * 2);
+    }
+    std::vector<int> probes;
+    for (int i = -5; i < 600005; i += 3) {
+        probes.push_back(i);
+    }
+    std::vector<char> probeAnswers(probes.size());
+    std::size_t batchFound = tall.contains_batch(probes.begin(), probes.end(), probeAnswers.begin());
+    int wrongAnswers = 0;
+    for (std::size_t i = 0; i < probes.size(); i++) {
+        wrongAnswers += (probeAnswers[i] != tall.contains(probes[i]));
+    }
+    cout << "Batch found in big tree: should be 100000: " << batchFound << endl;
+    cout << "Batch answers unlike contains: should be 0: " << wrongAnswers << endl;
+    AVLTree<int> nothing;
+    cout << "Batch found in empty tree: should be 0: " << nothing.contains_batch(probes.begin(), probes.end(), probeAnswers.begin()) << endl;
+    std::vector<long> longProbes(probes.begin(), probes.end());
+    cout << "Batch found from longs in big tree: should be 100000: "
+         << tall.contains_batch(longProbes.begin(), longProbes.end(), probeAnswers.begin()) << endl;
+    std::vector<long> smallLongs(lookups.begin(), lookups.end());
+    cout << "Batch found from longs in small tree: should be 4: "
+         << wide.contains_batch(smallLongs.begin(), smallLongs.end(), probeAnswers.begin()) << endl;
+    std::vector<bool> bits = {true, false, true};
+    cout << "Batch found from vector<bool> in big tree: should be 1: "
+         << tall.contains_batch(bits.begin(), bits.end(), probeAnswers.begin()) << endl;
+    AVLTree<std::string, NodePool, std::less<>> tallWords;
+    for (int i = 0; i < 300000; i += 2) {
+        tallWords.insert(std::to_string(i));
+    }
+    for (int i = 300001; i < 600000; i += 2) {
+        tallWords.insert(std::to_string(i));
+    }
+    std::vector<std::string> wordStore = {"0", "1", "299998", "299999", "300001", "599999", "x"};
+    std::vector<std::string_view> wordViews(wordStore.begin(), wordStore.end());
+    std::vector<bool> wordAnswers;
+    cout << "Batch found from string_views in big tree: should be 4: "
+         << tallWords.contains_batch(wordViews.begin(), wordViews.end(), std::back_inserter(wordAnswers)) << endl;
+    cout << "Batch string_view answers: should be 1 0 1 0 1 1 0: ";
+    for (bool a : wordAnswers) {
+        cout << a << ' ';
+    }
+    cout << endl;
+    cout << endl;
+
+    // comparator tests
+    AVLTree<int, NodePool, std::greater<int>> down;
+    for (int i = 1; i <= 10; i++) {
+        down.insert(i);
+    }
+    down.remove(4);
+    cout << "Greater first: should be 10 9 8 7 6 5 3 2 1: ";
+    for (int v : down) {
+        cout << v << ' ';
+    }
+    cout << endl;
+    cout << "Min by comparator: should be 10: " << down.find_min() << endl;
+    cout << "lower_bound(4): should be 3: " << *down.lower_bound(4) << endl;
+    cout << "rank(5): should be 5: " << down.rank(5) << endl;
+    std::vector<int> downBatch = {20, 1, 15, 0};
+    cout << "Batch inserted: should be 3: " << down.insert_batch(downBatch.begin(), downBatch.end()) << endl;
+    cout << "Max by comparator: should be 0: " << down.find_max() << endl;
+    AVLTree<std::string, NodePool, std::less<>> names; // transparent, so string_view lookups make no string
+    names.insert("delta");
+    names.insert("alpha");
+    names.insert("charlie");
+    std::string_view probe = "charlie";
+    cout << "Contains string_view charlie: should be 1: " << names.contains(probe) << endl;
+    cout << "Contains string_view bravo: should be 0: " << names.contains(std::string_view("bravo")) << endl;
+    cout << "Find string_view: should be charlie: " << *names.find(probe) << endl;
+    cout << "Find missing is end: should be 1: " << (names.find(std::string_view("echo")) == names.end()) << endl;
+    cout << "Find string: should be alpha: " << *names.find(std::string("alpha")) << endl;
+    // a comparator with state, which parallel set operations have to hand to their worker trees
+    struct Direction {
+        bool descending = false;
+        bool operator()(int a, int b) const { return descending ? b < a : a < b; }
+    };
+    AVLTree<int, NodePool, Direction> evensDown(Direction{true});
+    AVLTree<int, NodePool, Direction> oddsDown(Direction{true});
+    evensDown.set_parallelism(4);
+    for (int i = 0; i < 100000; i++) {
+        evensDown.insert(2 * i);
+        oddsDown.insert(2 * i + 1);
+    }
+    AVLTree<int, NodePool, Direction> unitedDown(evensDown);
+    unitedDown.union_with(oddsDown);
+    int misplaced = !std::is_sorted(unitedDown.begin(), unitedDown.end(), Direction{true});
+    for (int i = 0; i < 200000; i++) {
+        misplaced += !unitedDown.contains(i);
+    }
+    cout << "Parallel union with comparator, wrong answers: should be 0: " << misplaced << endl;
+    cout << "Parallel union with comparator, min: should be 199999: " << unitedDown.find_min() << endl;
+    AVLTree<int, NodePool, Direction> splitDown = unitedDown.split(65536);
+    cout << "Split with comparator, contains 65536: should be 1: " << splitDown.contains(65536) << endl;
+    cout << "Split with comparator, left max: should be 65537: " << unitedDown.find_max() << endl;
+    splitDown.remove(65536); // goes back in as the key
+    unitedDown = AVLTree<int, NodePool, Direction>::join(std::move(unitedDown), 65536, std::move(splitDown));
+    unitedDown.intersect_with(oddsDown);
+    misplaced = !std::is_sorted(unitedDown.begin(), unitedDown.end(), Direction{true});
+    for (int i = 0; i < 200000; i++) {
+        misplaced += (unitedDown.contains(i) != (i % 2 == 1));
+    }
+    cout << "Parallel intersection with comparator, wrong answers: should be 0: " << misplaced << endl;
+    unitedDown.union_with(evensDown);
+    unitedDown.difference_with(oddsDown);
+    misplaced = !std::is_sorted(unitedDown.begin(), unitedDown.end(), Direction{true});
+    for (int i = 0; i < 200000; i++) {
+        misplaced += (unitedDown.contains(i) != (i % 2 == 0));
+    }
+    cout << "Parallel difference with comparator, wrong answers: should be 0: " << misplaced << endl;
+    cout << "Size: should be 100000: " << unitedDown.size() << endl;
+    cout << endl;
+
+    // save and load tests
+    tall.save("avl_tree_tests.tree");
+    AVLTree<int> loaded;
+    loaded.insert(-5); // replaced by the load
+    loaded.load("avl_tree_tests.tree");
+    cout << "Loaded size: should be 300000: " << loaded.size() << endl;
+    cout << "Loaded min: should be 0: " << loaded.find_min() << endl;
+    cout << "Loaded max: should be 599998: " << loaded.find_max() << endl;
+    cout << "Loaded contains -5: should be 0: " << loaded.contains(-5) << endl;
+    cout << "Loaded same as saved: should be 1: " << std::equal(loaded.begin(), loaded.end(), tall.begin(), tall.end()) << endl;
+    nothing.save("avl_tree_tests.tree");
+    loaded.load("avl_tree_tests.tree");
+    cout << "Empty after loading empty tree: should be 1: " << loaded.is_empty() << endl;
+    AVLTree<int, NodePool, std::greater<int>> downLoaded;
+    down.save("avl_tree_tests.tree");
+    downLoaded.load("avl_tree_tests.tree");
+    cout << "Greater first loaded: should be 20 15 10 9 8 7 6 5 3 2 1 0: ";
+    for (int v : downLoaded) {
+        cout << v << ' ';
+    }
+    cout << endl;
+    try {
+        AVLTree<double> wrongType;
+        wrongType.load("avl_tree_tests.tree");
+    }
+    catch (const std::runtime_error&) {
+        cout << "Load of int file into double tree failed: success" << endl;
+    }
+    try {
+        loaded.load("no_such_file.tree");
+    }
+    catch (const std::runtime_error&) {
+        cout << "Load of missing file failed: success" << endl;
+    }
+    std::remove("avl_tree_tests.tree");
+    cout << endl;
+
+    // export tests
+    auto exported = [](const AVLTree<int>& tree, TreeFormat format, std::size_t depth) {
+        std::ostringstream os;
+        tree.export_tree(os, format, depth);
+        return os.str();
+    };
+    AVLTree<int> seven;
+    for (int i = 1; i <= 7; i++) {
+        seven.insert(i);
+    }
+    cout << exported(seven, TreeFormat::LevelOrder, NO_DEPTH_LIMIT);
+    cout << exported(seven, TreeFormat::Dot, 1);
+    cout << "Level order right: should be 1: "
+         << (exported(seven, TreeFormat::LevelOrder, NO_DEPTH_LIMIT) == "0: 4\n1: 2 6\n2: 1 3 5 7\n") << endl;
+    cout << "Level order to depth 1 right: should be 1: "
+         << (exported(seven, TreeFormat::LevelOrder, 1) == "0: 4\n1: 2 6\n") << endl;
+    cout << "Rotated to depth 1 right: should be 1: " << (exported(seven, TreeFormat::Rotated, 1) == "  6\n4\n  2\n") << endl;
+    cout << "Rotated same as print_tree: should be 1: " << (exported(seven, TreeFormat::Rotated, NO_DEPTH_LIMIT) == [&seven]() {
+        std::ostringstream os;
+        seven.print_tree(os);
+        return os.str();
+    }()) << endl;
+    cout << "JSON to depth 1 right: should be 1: " << (exported(seven, TreeFormat::Json, 1) ==
+        "{\"value\": 4, \"left\": {\"value\": 2, \"truncated\": true}, \"right\": {\"value\": 6, \"truncated\": true}}\n") << endl;
+    AVLTree<int> two;
+    two.insert(2);
+    two.insert(1);
+    cout << "JSON right: should be 1: " << (exported(two, TreeFormat::Json, NO_DEPTH_LIMIT) ==
+        "{\"value\": 2, \"left\": {\"value\": 1, \"left\": null, \"right\": null}, \"right\": null}\n") << endl;
+    cout << "JSON of empty tree right: should be 1: " << (exported(nothing, TreeFormat::Json, NO_DEPTH_LIMIT) == "null\n") << endl;
+    cout << "DOT right: should be 1: " << (exported(two, TreeFormat::Dot, NO_DEPTH_LIMIT) ==
+        "digraph tree {\n  node [shape=circle];\n  n0 [label=\"2\"];\n  n1 [label=\"1\"];\n  n0:sw -> n1;\n}\n") << endl;
+    std::ostringstream bigPrint;
+    tall.print_tree(bigPrint);
+    std::string bigText = bigPrint.str();
+    cout << "Lines printed for big tree: should be 300000: " << std::count(bigText.begin(), bigText.end(), '\n') << endl;
     return 0;
 }
@@ -0,0 +1,814 @@
+/*****************************************
+** File:    bench.cpp
+** Project: CSCE 221 Lab 4 Spring 2022
+** Author:  Naimur Rahman
+** Date:    03/21/2022
+** Section: 511
+** E-mail:  naimurrah01@tamu.edu
+** Description: Benchmarks for the trees, prints results as CSV
+**              usage: ./a.out [largest n, default 10000000]
+**/
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "avl_tree.h"
+#include "binary_search_tree.h"
+#include "bplus_tree.h"
+#include "compact_avl_tree.h"
+#include "concurrent_binary_search_tree.h"
+#include "mapped_tree.h"
+#include "persistent_avl_tree.h"
+#include "tree_map.h"
+
+using std::cout, std::endl;
+
+// AVL insert and remove as they were before they became iterative: recurse to
+// the bottom and call balance() on every node on the way back up. Kept here so
+// the iterative versions in AVLTree have something to be measured against.
+template <typename Comparable>
+class RecursiveAVLTree {
+private:
+    struct avlNode {
+        Comparable data;
+        avlNode *left = nullptr;
+        avlNode *right = nullptr;
+        int height = 0;
+    };
+
+    avlNode* root = nullptr;
+    NodePool<avlNode> allocator;
+    std::size_t rotations = 0;
+
+    int height(avlNode* t) { return (t == nullptr) ? -1 : t->height; }
+
+    void rotateWithLeftChild(avlNode*& k2) {
+        avlNode* k1 = k2->left;
+        k2->left = k1->right;
+        k1->right = k2;
+        k2->height = std::max(height(k2->left), height(k2->right)) + 1;
+        k1->height = std::max(height(k1->left), k2->height) + 1;
+        k2 = k1;
+        this->rotations++;
+    }
+
+    void rotateWithRightChild(avlNode*& k1) {
+        avlNode* k2 = k1->right;
+        k1->right = k2->left;
+        k2->left = k1;
+        k1->height = std::max(height(k1->left), height(k1->right)) + 1;
+        k2->height = std::max(height(k2->right), k1->height) + 1;
+        k1 = k2;
+        this->rotations++;
+    }
+
+    void balance(avlNode*& t) {
+        if (t == nullptr) {
+            return;
+        }
+        if (height(t->left) - height(t->right) > 1) {
+            if (height(t->left->left) < height(t->left->right)) {
+                rotateWithRightChild(t->left);
+            }
+            rotateWithLeftChild(t);
+        }
+        else if (height(t->right) - height(t->left) > 1) {
+            if (height(t->right->right) < height(t->right->left)) {
+                rotateWithLeftChild(t->right);
+            }
+            rotateWithRightChild(t);
+        }
+        t->height = std::max(height(t->left), height(t->right)) + 1;
+    }
+
+    void insertSub(const Comparable& x, avlNode*& t) {
+        if (t == nullptr) {
+            t = new (this->allocator.allocate()) avlNode{x};
+        }
+        else if (x < t->data) {
+            insertSub(x, t->left);
+        }
+        else if (x > t->data) {
+            insertSub(x, t->right);
+        }
+        balance(t);
+    }
+
+    void removeSub(const Comparable& x, avlNode*& t) {
+        if (t == nullptr) {
+            return;
+        }
+        if (x < t->data) {
+            removeSub(x, t->left);
+        }
+        else if (x > t->data) {
+            removeSub(x, t->right);
+        }
+        else if (t->left != nullptr && t->right != nullptr) {
+            avlNode* m = t->right;
+            while (m->left != nullptr) {
+                m = m->left;
+            }
+            t->data = m->data;
+            removeSub(t->data, t->right);
+        }
+        else {
+            avlNode* r = t;
+            t = (t->left != nullptr) ? t->left : t->right;
+            r->~avlNode();
+            this->allocator.deallocate(r);
+        }
+        balance(t);
+    }
+
+public:
+    void insert(const Comparable& x) { insertSub(x, this->root); }
+    void remove(const Comparable& x) { removeSub(x, this->root); }
+    std::size_t rotation_count() const { return this->rotations; }
+};
+
+// BinarySearchTree with set_rebalancing() turned on from the start
+class RebalancingBST : public BinarySearchTree<int> {
+public:
+    RebalancingBST() { set_rebalancing(true); }
+};
+
+// AVLTree behind one mutex, what the threaded benchmark is measured against
+class LockedAVLTree {
+private:
+    AVLTree<int> tree;
+    std::mutex lock;
+
+public:
+    bool insert(int x) {
+        std::lock_guard<std::mutex> guard(this->lock);
+        return this->tree.insert(x).second;
+    }
+    bool remove(int x) {
+        std::lock_guard<std::mutex> guard(this->lock);
+        if (!this->tree.contains(x)) {
+            return false;
+        }
+        this->tree.remove(x);
+        return true;
+    }
+    bool contains(int x) {
+        std::lock_guard<std::mutex> guard(this->lock);
+        return this->tree.contains(x);
+    }
+};
+
+// keys in an AVLTree and their values in an unordered_map beside it, what AVLMap is measured against
+class SplitAVLMap {
+private:
+    AVLTree<int> keys;
+    std::unordered_map<int, int> values;
+
+public:
+    int& operator[](int k) {
+        this->keys.insert(k);
+        return this->values[k];
+    }
+    void insert_or_assign(int k, int v) {
+        this->keys.insert(k);
+        this->values[k] = v;
+    }
+    std::size_t erase(int k) {
+        this->keys.remove(k);
+        return this->values.erase(k);
+    }
+};
+
+using Clock = std::chrono::steady_clock;
+
+// BinarySearchTree turns into a list on sorted input, so sizes past this take
+// quadratic time and are left out for the sequential and adversarial keys
+const std::size_t MAX_UNBALANCED = 10000;
+
+volatile std::size_t sink; // keeps results the compiler could otherwise drop
+
+//-------------------------------------------------------
+// Name: nsPerOp(Clock::time_point start, std::size_t ops)
+// PreCondition:  start time of the timed loop and how many operations it did
+// PostCondition: returns nanoseconds per operation since start
+//---------------------------------------------------------
+double nsPerOp(Clock::time_point start, std::size_t ops) {
+    std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    return elapsed.count() / static_cast<double>(ops);
+}
+
+//-------------------------------------------------------
+// Name: peakRssKb()
+// PreCondition:  none
+// PostCondition: returns the most memory this process has had resident, in kilobytes
+//---------------------------------------------------------
+long peakRssKb() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024; // bytes on macOS
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+// rotation_count() is only there on the AVL trees
+template <typename Tree, typename = void>
+struct CountsRotations : std::false_type {};
+template <typename Tree>
+struct CountsRotations<Tree, std::void_t<decltype(std::declval<Tree&>().rotation_count())>> : std::true_type {};
+
+template <typename Tree>
+double rotationsOf(const Tree& tree) {
+    if constexpr (CountsRotations<Tree>::value) {
+        return static_cast<double>(tree.rotation_count());
+    }
+    else {
+        return -1;
+    }
+}
+
+// one CSV row per tree, operation, key distribution and size
+struct Row {
+    std::string operation;
+    double ns;
+    double rotations; // per operation, negative when the tree does not count them
+};
+
+//-------------------------------------------------------
+// Name: makeKeys(const std::string& distribution, std::size_t n, std::mt19937& gen)
+// PreCondition:  name of a key distribution, number of keys and a random generator
+// PostCondition: returns n keys: sequential counts up, random is a shuffled permutation,
+//                zipfian repeats a few hot keys (roughly Zipf with s = 1) and adversarial counts down
+//---------------------------------------------------------
+std::vector<int> makeKeys(const std::string& distribution, std::size_t n, std::mt19937& gen) {
+    std::vector<int> keys(n);
+    if (distribution == "zipfian") {
+        // inverting the continuous CDF ln(k + 1) / ln(n + 1) gives P(k) close to 1 / (k + 1)
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        double logRange = std::log(static_cast<double>(n) + 1.0);
+        for (std::size_t i = 0; i < n; i++) {
+            std::uint32_t rank = static_cast<std::uint32_t>(std::exp(uniform(gen) * logRange) - 1.0);
+            keys[i] = static_cast<int>(rank * 2654435761u); // spread hot ranks over the key space
+        }
+        return keys;
+    }
+    for (std::size_t i = 0; i < n; i++) {
+        keys[i] = static_cast<int>(i);
+    }
+    if (distribution == "random") {
+        std::shuffle(keys.begin(), keys.end(), gen);
+    }
+    else if (distribution == "adversarial") {
+        std::reverse(keys.begin(), keys.end());
+    }
+    return keys;
+}
+
+//-------------------------------------------------------
+// Name: benchTree(const std::vector<int>& keys, std::vector<Row>& rows)
+// PreCondition:  tree type, keys to use and where to put the results
+// PostCondition: times insert, contains, find_min/find_max, copy, remove and destroy over the keys
+//---------------------------------------------------------
+template <typename Tree>
+void benchTree(const std::vector<int>& keys, std::vector<Row>& rows) {
+    std::size_t n = keys.size();
+    Tree tree;
+
+    Clock::time_point start = Clock::now();
+    for (int k : keys) {
+        tree.insert(k);
+    }
+    double insertRotations = rotationsOf(tree);
+    rows.push_back({"insert", nsPerOp(start, n), insertRotations / n});
+
+    std::size_t found = 0;
+    start = Clock::now();
+    for (int k : keys) {
+        found += tree.contains(k);
+    }
+    rows.push_back({"contains", nsPerOp(start, n), -1});
+    if (found != n) {
+        std::cerr << "contains() missed keys that were inserted" << endl;
+    }
+
+    start = Clock::now();
+    for (std::size_t i = 0; i < n; i++) {
+        sink = sink + ((i & 1) ? tree.find_max() : tree.find_min());
+    }
+    rows.push_back({"find_min_max", nsPerOp(start, n), -1});
+
+    start = Clock::now();
+    Tree copy(tree);
+    rows.push_back({"copy", nsPerOp(start, n), -1});
+
+    start = Clock::now();
+    for (int k : keys) {
+        tree.remove(k);
+    }
+    double removeRotations = CountsRotations<Tree>::value ? rotationsOf(tree) - insertRotations : -1;
+    rows.push_back({"remove", nsPerOp(start, n), removeRotations / n});
+
+    start = Clock::now();
+    copy.make_empty();
+    rows.push_back({"destroy", nsPerOp(start, n), -1});
+}
+
+//-------------------------------------------------------
+// Name: benchUpdates(const std::vector<int>& keys, std::vector<Row>& rows)
+// PreCondition:  tree type with only insert, remove and rotation_count, keys and where to put the results
+// PostCondition: times inserting then removing every key
+//---------------------------------------------------------
+template <typename Tree>
+void benchUpdates(const std::vector<int>& keys, std::vector<Row>& rows) {
+    std::size_t n = keys.size();
+    Tree tree;
+    Clock::time_point start = Clock::now();
+    for (int k : keys) {
+        tree.insert(k);
+    }
+    double insertRotations = rotationsOf(tree);
+    rows.push_back({"insert", nsPerOp(start, n), insertRotations / n});
+
+    start = Clock::now();
+    for (int k : keys) {
+        tree.remove(k);
+    }
+    rows.push_back({"remove", nsPerOp(start, n), (rotationsOf(tree) - insertRotations) / n});
+}
+
+//-------------------------------------------------------
+// Name: benchBatches(const std::vector<int>& keys, std::vector<Row>& rows)
+// PreCondition:  tree type with insert_batch and remove_batch, keys to use and where to put the results
+// PostCondition: times inserting then removing the keys in 1, 8 and 64 batches, to compare with one at a time
+//---------------------------------------------------------
+template <typename Tree>
+void benchBatches(const std::vector<int>& keys, std::vector<Row>& rows) {
+    static const char* const INSERTS[] = {"insert_batch_1", "insert_batch_8", "insert_batch_64"};
+    static const char* const REMOVES[] = {"remove_batch_1", "remove_batch_8", "remove_batch_64"};
+    std::size_t n = keys.size();
+    for (int i = 0; i < 3; i++) {
+        std::size_t batches = std::size_t(1) << (3 * i);
+        std::size_t chunk = (n + batches - 1) / batches;
+        Tree tree;
+        Clock::time_point start = Clock::now();
+        for (std::size_t b = 0; b < n; b += chunk) {
+            tree.insert_batch(keys.begin() + b, keys.begin() + std::min(n, b + chunk));
+        }
+        rows.push_back({INSERTS[i], nsPerOp(start, n), -1});
+
+        start = Clock::now();
+        for (std::size_t b = 0; b < n; b += chunk) {
+            tree.remove_batch(keys.begin() + b, keys.begin() + std::min(n, b + chunk));
+        }
+        rows.push_back({REMOVES[i], nsPerOp(start, n), -1});
+    }
+}
+
+//-------------------------------------------------------
+// Name: benchRemoveBatchSizes(const std::vector<int>& keys, std::vector<Row>& rows)
+// PreCondition:  tree type with remove_batch, keys to use and where to put the results
+// PostCondition: times one remove_batch of 1/2 up to 4 times the size of the tree, per value of the batch, so
+//                the batches on either side of AVLTree's REMOVE_REBUILD_FACTOR of 2 take either path
+//---------------------------------------------------------
+template <typename Tree>
+void benchRemoveBatchSizes(const std::vector<int>& keys, std::vector<Row>& rows) {
+    static const char* const RATIOS[] = {"1/2", "1", "3/2", "2", "3", "4"};
+    static const std::size_t BATCH_PARTS[] = {1, 1, 3, 2, 3, 4}; // batch to tree size, BATCH_PARTS : TREE_PARTS
+    static const std::size_t TREE_PARTS[] = {2, 1, 2, 1, 1, 1};
+    std::size_t n = keys.size();
+    for (int i = 0; i < 6; i++) {
+        // the tree holds the first t keys and the batch is the first m, so past t it holds keys not in the tree
+        std::size_t t = n * TREE_PARTS[i] / (BATCH_PARTS[i] + TREE_PARTS[i]);
+        std::size_t m = std::min(n, t * BATCH_PARTS[i] / TREE_PARTS[i]);
+        Tree tree(keys.begin(), keys.begin() + t);
+        Clock::time_point start = Clock::now();
+        tree.remove_batch(keys.begin(), keys.begin() + m);
+        rows.push_back({std::string("remove_batch_x") + RATIOS[i], nsPerOp(start, m), -1});
+        sink = tree.size();
+    }
+}
+
+//-------------------------------------------------------
+// Name: benchSetOps(const std::vector<int>& keys, std::vector<Row>& rows)
+// PreCondition:  tree type with the set operations, keys to use and where to put the results
+// PostCondition: times union, intersection and difference of a tree of the keys with one a sixteenth its size,
+//                per value of the smaller tree
+//---------------------------------------------------------
+template <typename Tree>
+void benchSetOps(const std::vector<int>& keys, std::vector<Row>& rows) {
+    Tree big(keys.begin(), keys.end());
+    Tree small;
+    for (std::size_t i = 0; i < keys.size(); i += 16) {
+        small.insert(keys[i] ^ 1); // about half of them already in big
+    }
+    std::size_t m = std::max<std::size_t>(small.size(), 1);
+
+    Tree a(big);
+    Clock::time_point start = Clock::now();
+    a.union_with(small);
+    rows.push_back({"union_with", nsPerOp(start, m), -1});
+
+    a = big;
+    start = Clock::now();
+    a.intersect_with(small);
+    rows.push_back({"intersect_with", nsPerOp(start, m), -1});
+
+    a = big;
+    start = Clock::now();
+    a.difference_with(small);
+    rows.push_back({"difference_with", nsPerOp(start, m), -1});
+}
+
+//-------------------------------------------------------
+// Name: benchParallel(const std::vector<int>& keys, std::vector<Row>& rows)
+// PreCondition:  tree type with set_parallelism, keys to use and where to put the results
+// PostCondition: times building, copying and union with every hardware thread allowed, to compare with
+//                the single threaded copy and union_with rows
+//---------------------------------------------------------
+template <typename Tree>
+void benchParallel(const std::vector<int>& keys, std::vector<Row>& rows) {
+    std::size_t n = keys.size();
+    Tree tree;
+    tree.set_parallelism(0);
+    Clock::time_point start = Clock::now();
+    tree.assign(keys.begin(), keys.end());
+    rows.push_back({"assign_parallel", nsPerOp(start, n), -1});
+
+    start = Clock::now();
+    Tree copy(tree);
+    rows.push_back({"copy_parallel", nsPerOp(start, n), -1});
+
+    Tree small;
+    for (std::size_t i = 0; i < n; i += 16) {
+        small.insert(keys[i] ^ 1);
+    }
+    start = Clock::now();
+    copy.union_with(small);
+    rows.push_back({"union_with_parallel", nsPerOp(start, std::max<std::size_t>(small.size(), 1)), -1});
+}
+
+//-------------------------------------------------------
+// Name: benchFrozen(const std::vector<int>& keys, std::vector<Row>& rows)
+// PreCondition:  tree type with freeze(), keys to use and where to put the results
+// PostCondition: times freezing a tree of the keys, then contains and lower_bound on the frozen copy,
+//                to set against the contains row of the tree itself
+//---------------------------------------------------------
+template <typename Tree>
+void benchFrozen(const std::vector<int>& keys, std::vector<Row>& rows) {
+    std::size_t n = keys.size();
+    Tree tree(keys.begin(), keys.end());
+    Clock::time_point start = Clock::now();
+    auto frozen = tree.freeze();
+    rows.push_back({"freeze", nsPerOp(start, n), -1});
+
+    std::size_t found = 0;
+    start = Clock::now();
+    for (int k : keys) {
+        found += frozen.contains(k);
+    }
+    rows.push_back({"frozen_contains", nsPerOp(start, n), -1});
+    if (found != n) {
+        std::cerr << "frozen contains() missed keys that were inserted" << endl;
+    }
+
+    start = Clock::now();
+    for (int k : keys) {
+        sink = sink + (frozen.lower_bound(k ^ 1) != frozen.end());
+    }
+    rows.push_back({"frozen_lower_bound", nsPerOp(start, n), -1});
+}
+
+//-------------------------------------------------------
+// Name: benchLookups(const std::vector<int>& keys, std::vector<Row>& rows)
+// PreCondition:  tree type with contains_batch(), keys to use and where to put the results
+// PostCondition: times looking every key up in shuffled order, one contains() at a time and all at once
+//                with contains_batch(), so the lookups miss the cache the same way in both rows
+//---------------------------------------------------------
+template <typename Tree>
+void benchLookups(const std::vector<int>& keys, std::vector<Row>& rows) {
+    std::size_t n = keys.size();
+    Tree tree(keys.begin(), keys.end());
+    std::vector<int> probes(keys);
+    std::mt19937 gen(221);
+    std::shuffle(probes.begin(), probes.end(), gen);
+
+    std::size_t found = 0;
+    Clock::time_point start = Clock::now();
+    for (int k : probes) {
+        found += tree.contains(k);
+    }
+    rows.push_back({"contains_loop", nsPerOp(start, n), -1});
+
+    std::vector<char> hits(n);
+    start = Clock::now();
+    std::size_t batchFound = tree.contains_batch(probes.begin(), probes.end(), hits.begin());
+    rows.push_back({"contains_batch", nsPerOp(start, n), -1});
+    if (batchFound != found) {
+        std::cerr << "contains_batch() and contains() disagree" << endl;
+    }
+    sink = sink + batchFound;
+}
+
+//-------------------------------------------------------
+// Name: benchFiles(const std::vector<int>& keys, std::vector<Row>& rows)
+// PreCondition:  tree type with save() and load(), keys to use and where to put the results
+// PostCondition: times saving a tree of the keys and loading it back, to set against its insert row,
+//                then mapping the file and looking every key up in it
+//---------------------------------------------------------
+template <typename Tree>
+void benchFiles(const std::vector<int>& keys, std::vector<Row>& rows) {
+    std::size_t n = keys.size();
+    std::string path = "bench_" + std::to_string(getpid()) + ".tree";
+    Tree tree(keys.begin(), keys.end());
+    Clock::time_point start = Clock::now();
+    tree.save(path);
+    rows.push_back({"save", nsPerOp(start, n), -1});
+
+    Tree loaded;
+    start = Clock::now();
+    loaded.load(path);
+    rows.push_back({"load", nsPerOp(start, n), -1});
+    if (!std::equal(loaded.begin(), loaded.end(), tree.begin(), tree.end())) {
+        std::cerr << "load() did not give back the keys saved" << endl;
+    }
+
+    start = Clock::now();
+    MappedTree<int> mapped(path);
+    rows.push_back({"mapped_open", nsPerOp(start, n), -1});
+    std::size_t found = 0;
+    start = Clock::now();
+    for (int k : keys) {
+        found += mapped.contains(k);
+    }
+    rows.push_back({"mapped_contains", nsPerOp(start, n), -1});
+    if (found != n) {
+        std::cerr << "mapped contains() missed keys that were saved" << endl;
+    }
+    std::remove(path.c_str());
+}
+
+//-------------------------------------------------------
+// Name: benchExport(const std::vector<int>& keys, std::vector<Row>& rows)
+// PreCondition:  tree type with export_tree(), keys to use and where to put the results
+// PostCondition: times print_tree() and every export format of a tree of the keys, written to /dev/null
+//                so the time is formatting and write calls, not the disk
+//---------------------------------------------------------
+template <typename Tree>
+void benchExport(const std::vector<int>& keys, std::vector<Row>& rows) {
+    std::size_t n = keys.size();
+    Tree tree(keys.begin(), keys.end());
+    std::ofstream out("/dev/null");
+    Clock::time_point start = Clock::now();
+    tree.print_tree(out);
+    rows.push_back({"print_tree", nsPerOp(start, n), -1});
+
+    const std::pair<const char*, TreeFormat> formats[] = {
+        {"export_dot", TreeFormat::Dot}, {"export_json", TreeFormat::Json}, {"export_level_order", TreeFormat::LevelOrder}};
+    for (const std::pair<const char*, TreeFormat>& format : formats) {
+        start = Clock::now();
+        tree.export_tree(out, format.second);
+        rows.push_back({format.first, nsPerOp(start, n), -1});
+    }
+}
+
+//-------------------------------------------------------
+// Name: benchMap(const std::vector<int>& keys, std::vector<Row>& rows)
+// PreCondition:  map type from int to int, keys to use and where to put the results
+// PostCondition: times storing a value for every key with insert_or_assign(), reading it back with
+//                operator[] and erasing every key
+//---------------------------------------------------------
+template <typename Map>
+void benchMap(const std::vector<int>& keys, std::vector<Row>& rows) {
+    std::size_t n = keys.size();
+    Map map;
+    Clock::time_point start = Clock::now();
+    for (int k : keys) {
+        map.insert_or_assign(k, k);
+    }
+    rows.push_back({"map_insert_or_assign", nsPerOp(start, n), -1});
+
+    std::size_t total = 0;
+    start = Clock::now();
+    for (int k : keys) {
+        total += map[k];
+    }
+    rows.push_back({"map_read", nsPerOp(start, n), -1});
+    sink = sink + total;
+
+    start = Clock::now();
+    for (int k : keys) {
+        map.erase(k);
+    }
+    rows.push_back({"map_erase", nsPerOp(start, n), -1});
+}
+
+//-------------------------------------------------------
+// Name: benchSnapshot(const std::vector<int>& keys, std::vector<Row>& rows)
+// PreCondition:  tree type with snapshot(), keys to use and where to put the results
+// PostCondition: times insert and contains, taking a snapshot (total, not per value, to set against the
+//                copy row of the other trees) and removing every key while the snapshot is held
+//---------------------------------------------------------
+template <typename Tree>
+void benchSnapshot(const std::vector<int>& keys, std::vector<Row>& rows) {
+    std::size_t n = keys.size();
+    Tree tree;
+    Clock::time_point start = Clock::now();
+    for (int k : keys) {
+        tree.insert(k);
+    }
+    rows.push_back({"insert", nsPerOp(start, n), -1});
+
+    std::size_t found = 0;
+    start = Clock::now();
+    for (int k : keys) {
+        found += tree.contains(k);
+    }
+    rows.push_back({"contains", nsPerOp(start, n), -1});
+    sink = sink + found;
+
+    start = Clock::now();
+    typename Tree::Snapshot snap = tree.snapshot();
+    rows.push_back({"snapshot_total", nsPerOp(start, 1), -1});
+
+    start = Clock::now();
+    for (int k : keys) {
+        tree.remove(k);
+    }
+    rows.push_back({"remove_with_snapshot", nsPerOp(start, n), -1});
+    sink = sink + snap.size();
+}
+
+//-------------------------------------------------------
+// Name: benchThreads(const std::vector<int>& keys, std::vector<Row>& rows)
+// PreCondition:  tree type safe to use from many threads, keys to use and where to put the results
+// PostCondition: fills a tree with half the keys, then times a mix of 60% contains, 20% insert and
+//                20% remove split over 1, 2, 4, ... threads up to every hardware thread. ns_per_op is
+//                wall time over all operations, so it falls as throughput rises.
+//---------------------------------------------------------
+template <typename Tree>
+void benchThreads(const std::vector<int>& keys, std::vector<Row>& rows) {
+    std::size_t n = keys.size();
+    unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1; ; threads = std::min(threads * 2, hardware)) {
+        Tree tree;
+        for (std::size_t i = 0; i < n; i += 2) {
+            tree.insert(keys[i]);
+        }
+        std::vector<std::thread> workers;
+        Clock::time_point start = Clock::now();
+        for (unsigned w = 0; w < threads; w++) {
+            workers.emplace_back([&tree, &keys, n, threads, w]() {
+                std::mt19937 gen(w);
+                std::size_t hits = 0;
+                for (std::size_t i = w; i < n; i += threads) {
+                    int key = keys[gen() % n];
+                    unsigned roll = gen() % 10;
+                    if (roll < 2) {
+                        hits += tree.insert(key);
+                    }
+                    else if (roll < 4) {
+                        hits += tree.remove(key);
+                    }
+                    else {
+                        hits += tree.contains(key);
+                    }
+                }
+                sink = sink + hits;
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        rows.push_back({"mixed_threads_" + std::to_string(threads), nsPerOp(start, n), -1});
+        if (threads == hardware) {
+            break;
+        }
+    }
+}
+
+//-------------------------------------------------------
+// Name: benchWritesWithReaders(const std::vector<int>& keys, std::vector<Row>& rows)
+// PreCondition:  tree type with lock-free readers, keys to use and where to put the results
+// PostCondition: times one writer inserting then removing every key while every other hardware thread
+//                (at least one) keeps calling contains, so writers waiting on readers show up here
+//---------------------------------------------------------
+template <typename Tree>
+void benchWritesWithReaders(const std::vector<int>& keys, std::vector<Row>& rows) {
+    std::size_t n = keys.size();
+    unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    Tree tree;
+    std::atomic<bool> done{false};
+    std::vector<std::thread> readers;
+    for (unsigned r = 0; r < std::max(1u, hardware - 1); r++) {
+        readers.emplace_back([&tree, &keys, &done, n, r]() {
+            std::mt19937 gen(r);
+            std::size_t hits = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                hits += tree.contains(keys[gen() % n]);
+            }
+            sink = sink + hits;
+        });
+    }
+
+    Clock::time_point start = Clock::now();
+    for (int k : keys) {
+        tree.insert(k);
+    }
+    rows.push_back({"insert_with_readers", nsPerOp(start, n), -1});
+
+    start = Clock::now();
+    for (int k : keys) {
+        tree.remove(k);
+    }
+    rows.push_back({"remove_with_readers", nsPerOp(start, n), -1});
+
+    done = true;
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+}
+
+//-------------------------------------------------------
+// Name: runCase(const char* name, Bench bench, const std::string& distribution, std::size_t n)
+// PreCondition:  tree name, benchmark function for it, key distribution and size
+// PostCondition: runs the benchmark in a child process, so the peak memory printed belongs to this case alone
+//---------------------------------------------------------
+template <typename Bench>
+void runCase(const char* name, Bench bench, const std::string& distribution, std::size_t n) {
+    cout.flush();
+    pid_t child = fork();
+    if (child == 0) {
+        std::mt19937 gen(221);
+        std::vector<int> keys = makeKeys(distribution, n, gen);
+        std::vector<Row> rows;
+        bench(keys, rows);
+        long rss = peakRssKb();
+        for (const Row& row : rows) {
+            cout << name << ',' << row.operation << ',' << distribution << ',' << n << ',' << row.ns << ',';
+            if (row.rotations >= 0) {
+                cout << row.rotations;
+            }
+            cout << ',' << rss << '\n';
+        }
+        cout.flush();
+        std::_Exit(0);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        std::cerr << name << ' ' << distribution << ' ' << n << " failed" << endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t maxN = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    cout << "tree,operation,distribution,n,ns_per_op,rotations_per_op,peak_rss_kb" << endl;
+    for (std::size_t n = 1000; n <= maxN; n *= 10) {
+        for (const char* distribution : {"sequential", "random", "zipfian", "adversarial"}) {
+            std::string d = distribution;
+            runCase("AVLTree", benchTree<AVLTree<int>>, d, n);
+            runCase("AVLTree", benchBatches<AVLTree<int>>, d, n);
+            runCase("AVLTree", benchRemoveBatchSizes<AVLTree<int>>, d, n);
+            runCase("AVLTree", benchSetOps<AVLTree<int>>, d, n);
+            runCase("AVLTree", benchParallel<AVLTree<int>>, d, n);
+            runCase("AVLTree", benchFrozen<AVLTree<int>>, d, n);
+            runCase("AVLTree", benchLookups<AVLTree<int>>, d, n);
+            runCase("AVLTree", benchFiles<AVLTree<int>>, d, n);
+            runCase("AVLTree", benchExport<AVLTree<int>>, d, n);
+            runCase("AVLMap", benchMap<AVLMap<int, int>>, d, n);
+            runCase("SplitAVLMap", benchMap<SplitAVLMap>, d, n);
+            runCase("RecursiveAVLTree", benchUpdates<RecursiveAVLTree<int>>, d, n);
+            runCase("CompactAVLTree", benchTree<CompactAVLTree<int>>, d, n);
+            runCase("BPlusTree", benchTree<BPlusTree<int>>, d, n);
+            if (n <= MAX_UNBALANCED || d == "random" || d == "zipfian") {
+                runCase("BinarySearchTree", benchTree<BinarySearchTree<int>>, d, n);
+            }
+            runCase("RebalancingBST", benchTree<RebalancingBST>, d, n);
+            runCase("PersistentAVLTree", benchSnapshot<PersistentAVLTree<int>>, d, n);
+            runCase("PersistentAVLTree", benchWritesWithReaders<PersistentAVLTree<int>>, d, n);
+            runCase("LockedAVLTree", benchThreads<LockedAVLTree>, d, n);
+            if (n <= MAX_UNBALANCED || d == "random" || d == "zipfian") {
+                runCase("ConcurrentBinarySearchTree", benchThreads<ConcurrentBinarySearchTree<int>>, d, n);
+            }
+        }
+    }
+    return 0;
+}
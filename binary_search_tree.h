@@ -10,12 +10,28 @@
 #ifndef BINARY_SEARCH_TREE_H
 #define BINARY_SEARCH_TREE_H
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "frozen_tree.h"
+#include "node_pool.h"
+#include "three_way.h"
+#include "tree_file.h"
+#include "tree_print.h"
 
 using std::cout, std::endl;
 
-template <typename Comparable>
+// Values are ordered by Compare, std::less by default, and every walk down the tree
+// makes one three_way() comparison per node, see three_way.h.
+template <typename Comparable, template <typename> class NodeAllocator = NodePool, typename Compare = std::less<Comparable>>
 class BinarySearchTree {
 private:
     // Node Struct for tree
@@ -23,68 +39,405 @@ private:
         Comparable data;
         Node* left = nullptr;
         Node* right = nullptr;
+        Node* parent = nullptr;
     };
 
     Node* root; // pointer to root of tree
+    NodeAllocator<Node> allocator; // storage for the nodes of the tree
+    Compare comp; // order of the values
+    std::size_t count = 0; // number of values in the tree
+    std::size_t maxCount = 0; // most values held since the last full rebuild, when rebalancing
+    bool rebalancing = false; // rebuild subtrees that grow too deep, see set_rebalancing()
+
+    // maps keep their entries in a tree and search it by key alone, see tree_map.h
+    template <typename Key, typename Value, typename Tree>
+    friend class TreeMap;
+
+    //-------------------------------------------------------
+    // Name: createNode(Args&&... args)
+    // PreCondition:  arguments for a Comparable constructor given
+    // PostCondition: returns a new leaf node whose data is built in place from args, taken from the allocator
+    //---------------------------------------------------------
+    template <typename... Args>
+    Node* createNode(Args&&... args) {
+        Node* n = this->allocator.allocate();
+        try {
+            new (n) Node{Comparable(std::forward<Args>(args)...)};
+        }
+        catch (...) { // give the storage back if building the data throws
+            this->allocator.deallocate(n);
+            throw;
+        }
+        return n;
+    }
+
+    //-------------------------------------------------------
+    // Name: destroyNode(Node* n)
+    // PreCondition:  node n unlinked from the tree
+    // PostCondition: destroys n and returns its storage to the allocator
+    //---------------------------------------------------------
+    void destroyNode(Node* n) {
+        n->~Node();
+        this->allocator.deallocate(n);
+    }
     
     //-------------------------------------------------------
-    // Name: find_min_ptr(Node*& n)
-    // PreCondition:  Node n passed by reference
-    // PostCondition: returns node pointer of node with minimum value of tree with root n recursively
+    // Name: find_min_ptr(Node* n)
+    // PreCondition:  Node n given
+    // PostCondition: returns node pointer of node with minimum value of tree with root n, walking down without recursing
     //---------------------------------------------------------
-    Node* find_min_ptr(Node*& n) const {
+    Node* find_min_ptr(Node* n) const {
         if (n == nullptr) {
             return nullptr;
         }
-        if (n->left == nullptr) {
-            return n;
+        while (n->left != nullptr) {
+            n = n->left;
         }
-        return find_min_ptr(n->left);
+        return n;
     }
 
-    // remove() helper
+    //-------------------------------------------------------
+    // Name: findNode(const Key& value)
+    // PreCondition: Comparable value, or a key that compares with the values, given
+    // PostCondition: returns the node holding value, nullptr if value is not in the tree
+    //---------------------------------------------------------
+    template <typename Key>
+    Node* findNode(const Key& value) const {
+        Node* current = this->root;
+        while (current != nullptr) {
+            int c = three_way(this->comp, value, current->data);
+            if (c == 0) {
+                break;
+            }
+            current = (c < 0) ? current->left : current->right;
+        }
+        return current;
+    }
+
+    // insert() helpers
+
+    //-------------------------------------------------------
+    // Name: findSlot(const Key& value, Node*& parent)
+    // PreCondition: Comparable value, or a key that compares with the values, given
+    // PostCondition: returns the empty link where value belongs and sets parent to the node owning it,
+    //                or returns nullptr and sets parent to the node holding value if value is already in the tree
+    //---------------------------------------------------------
+    template <typename Key>
+    Node** findSlot(const Key& value, Node*& parent) {
+        parent = nullptr;
+        Node** link = &this->root;
+        while (*link != nullptr) { // walk down to the empty spot for value
+            parent = *link;
+            int c = three_way(this->comp, value, parent->data);
+            if (c == 0) { // value in tree already
+                return nullptr;
+            }
+            else if (c < 0) { // shift to left
+                link = &parent->left;
+            }
+            else { // shift to right
+                link = &parent->right;
+            }
+        }
+        return link;
+    }
+
+    //-------------------------------------------------------
+    // Name: hintSlot(const Node* next, const Comparable& value, Node*& parent)
+    // PreCondition: node next that the caller expects to follow value in order, nullptr meaning value goes last
+    // PostCondition: same as findSlot(), but when value fits right before next the empty link is found
+    //                next to next or its predecessor without comparing down from the root
+    //---------------------------------------------------------
+    Node** hintSlot(const Node* next, const Comparable& value, Node*& parent) {
+        if (next == nullptr || this->comp(value, next->data)) {
+            const Node* prev;
+            if (next != nullptr) {
+                prev = predecessor(next);
+            }
+            else { // value goes after the maximum
+                prev = this->root;
+                while (prev != nullptr && prev->right != nullptr) {
+                    prev = prev->right;
+                }
+            }
+            if (prev == nullptr || this->comp(prev->data, value)) { // hint is right, value sits between prev and next
+                // one of the two always has its link towards the other free
+                if (prev != nullptr && prev->right == nullptr) {
+                    parent = const_cast<Node*>(prev);
+                    return &parent->right;
+                }
+                if (next != nullptr) {
+                    parent = const_cast<Node*>(next);
+                    return &parent->left;
+                }
+                parent = nullptr; // empty tree
+                return &this->root;
+            }
+        }
+        return findSlot(value, parent); // wrong hint
+    }
 
     //-------------------------------------------------------
-    // Name: deleteFromTree(const Comparable& value, Node*& p)
-    // PreCondition:  Comparable value and avlNode p passed as parameters
-    // PostCondition: removes item with value as data at tree root p through recursion
+    // Name: insertAt(Node** link, Node* parent, Args&&... args)
+    // PreCondition: link and parent found by findSlot() or hintSlot() for the value args build, such as
+    //               the value itself as an lvalue or rvalue
+    // PostCondition: builds the value from args in a new node hung from link, unless link is nullptr because
+    //                the value is already there. Returns the node holding the value.
     //---------------------------------------------------------
-    void deleteFromTree(const Comparable& value, Node*& p) {
-        if (p == nullptr) {
+    template <typename... Args>
+    Node* insertAt(Node** link, Node* parent, Args&&... args) {
+        if (link == nullptr) { // value in tree already, parent holds it
+            return parent;
+        }
+        Node* item = createNode(std::forward<Args>(args)...); // only built once we know it goes in
+        addNode(item, parent, link);
+        return item;
+    }
+
+    //-------------------------------------------------------
+    // Name: addNode(Node* item, Node* parent, Node** link)
+    // PreCondition: new leaf item and the empty link and parent found for it by findSlot() or hintSlot()
+    // PostCondition: hangs item from parent, rebuilding the subtree of a scapegoat above it if it went too deep
+    //---------------------------------------------------------
+    void addNode(Node* item, Node* parent, Node** link) {
+        item->parent = parent;
+        *link = item;
+        this->count++;
+        if (!this->rebalancing) {
+            return;
+        }
+        this->maxCount = std::max(this->maxCount, this->count);
+        std::size_t depth = 0;
+        for (Node* p = parent; p != nullptr; p = p->parent) { // path was just walked, so this stays in cache
+            depth++;
+        }
+        if (depth <= maxDepth(this->count)) {
             return;
         }
 
-        if (value < p->data) { // go to left branch
-            deleteFromTree(value, p->left);
+        // climb until a child holds more than 2/3 of its parent's subtree; one such
+        // parent is always found when the new node is deeper than maxDepth()
+        std::size_t size = 1; // nodes under child
+        Node* child = item;
+        for (Node* p = item->parent; p != nullptr; p = p->parent) {
+            Node* sibling = (p->left == child) ? p->right : p->left;
+            std::size_t parentSize = size + subtreeSize(sibling) + 1;
+            if (3 * size > 2 * parentSize) {
+                rebuild(p, parentSize);
+                return;
+            }
+            size = parentSize;
+            child = p;
         }
-        else if (p->data < value) { // go to right branch
-            deleteFromTree(value, p->right);
+    }
+
+    // rebalancing helpers
+
+    //-------------------------------------------------------
+    // Name: maxDepth(std::size_t n)
+    // PreCondition:  number of values n given
+    // PostCondition: returns the deepest a node may sit in a tree of n values before it is rebuilt, log base 3/2 of n
+    //---------------------------------------------------------
+    static std::size_t maxDepth(std::size_t n) {
+        return static_cast<std::size_t>(std::log(static_cast<double>(n)) / std::log(1.5));
+    }
+
+    //-------------------------------------------------------
+    // Name: subtreeSize(Node* p)
+    // PreCondition:  node p given, can be nullptr
+    // PostCondition: returns the number of nodes in the subtree rooted at p
+    //---------------------------------------------------------
+    static std::size_t subtreeSize(Node* p) {
+        std::size_t size = 0;
+        std::vector<Node*> pending;
+        if (p != nullptr) {
+            pending.push_back(p);
         }
-        else if (p->left != nullptr && p->right != nullptr) { // node has no children
-            p->data = find_min_ptr(p->right)->data;
-            deleteFromTree(p->data, p->right);
+        while (!pending.empty()) {
+            Node* n = pending.back();
+            pending.pop_back();
+            size++;
+            if (n->left != nullptr) {
+                pending.push_back(n->left);
+            }
+            if (n->right != nullptr) {
+                pending.push_back(n->right);
+            }
+        }
+        return size;
+    }
+
+    //-------------------------------------------------------
+    // Name: rebuild(Node* p, std::size_t n)
+    // PreCondition:  node p at the top of a subtree of n nodes
+    // PostCondition: relinks the same nodes into a perfectly balanced subtree in p's place, without allocating nodes
+    //---------------------------------------------------------
+    void rebuild(Node* p, std::size_t n) {
+        Node* parent = p->parent;
+        Node** link = (parent == nullptr) ? &this->root : (parent->left == p) ? &parent->left : &parent->right;
+
+        std::vector<Node*> nodes; // nodes of the subtree in order
+        nodes.reserve(n);
+        std::vector<Node*> pending; // nodes whose left side has been visited but not themselves
+        Node* current = p;
+        while (current != nullptr || !pending.empty()) {
+            while (current != nullptr) { // go as far left as possible
+                pending.push_back(current);
+                current = current->left;
+            }
+            current = pending.back();
+            pending.pop_back();
+            nodes.push_back(current);
+            current = current->right;
+        }
+
+        *link = relinkNodes(nodes.data(), nodes.size());
+        (*link)->parent = parent;
+    }
+
+    //-------------------------------------------------------
+    // Name: relinkNodes(Node** nodes, std::size_t n)
+    // PreCondition:  n nodes in order starting at nodes
+    // PostCondition: links the nodes into a perfectly balanced subtree and returns its root
+    //---------------------------------------------------------
+    static Node* relinkNodes(Node** nodes, std::size_t n) {
+        if (n == 0) {
+            return nullptr;
+        }
+        std::size_t mid = n / 2; // middle node becomes the root
+        Node* p = nodes[mid];
+        p->left = relinkNodes(nodes, mid);
+        p->right = relinkNodes(nodes + mid + 1, n - mid - 1);
+        if (p->left != nullptr) {
+            p->left->parent = p;
+        }
+        if (p->right != nullptr) {
+            p->right->parent = p;
+        }
+        return p;
+    }
+
+    // remove() helper
+
+    //-------------------------------------------------------
+    // Name: deleteFromTree(const Key& value)
+    // PreCondition:  Comparable value, or a key that compares with the values, given
+    // PostCondition: removes item with value as data, walking down with a loop so a tree that has become a
+    //                list does not run out of call stack
+    //---------------------------------------------------------
+    template <typename Key>
+    void deleteFromTree(const Key& value) {
+        Node** link = &this->root;
+        while (*link != nullptr) { // walk down to the link holding value
+            int c = three_way(this->comp, value, (*link)->data);
+            if (c == 0) {
+                break;
+            }
+            link = (c < 0) ? &(*link)->left : &(*link)->right;
+        }
+        Node*& p = *link;
+        if (p == nullptr) { // value not in tree
+            return;
+        }
+
+        if (p->left != nullptr && p->right != nullptr) { // two children, successor node takes p's place
+            Node* oldNode = p;
+            Node* s = find_min_ptr(p->right);
+            if (s != p->right) { // unhook s from the bottom of the right subtree
+                s->parent->left = s->right;
+                if (s->right != nullptr) {
+                    s->right->parent = s->parent;
+                }
+                s->right = p->right;
+                s->right->parent = s;
+            }
+            s->left = p->left;
+            s->left->parent = s;
+            s->parent = p->parent;
+            p = s;
+            destroyNode(oldNode);
+            this->count--;
         }
         else { // at least one or more has children
             Node *oldNode = p;
             p = (p->left != nullptr) ? p->left : p->right; // p = p->left is p->left is not a nullptr else p = p->right
-            delete oldNode;
+            if (p != nullptr) {
+                p->parent = oldNode->parent;
+            }
+            destroyNode(oldNode);
+            this->count--;
         }
     }
 
+    //-------------------------------------------------------
+    // Name: removeKey(const Key& value)
+    // PreCondition:  Comparable value, or a key that compares with the values, given
+    // PostCondition: removes the node holding value in one walk down, returns whether there was one
+    //---------------------------------------------------------
+    template <typename Key>
+    bool removeKey(const Key& value) {
+        std::size_t before = this->count;
+        deleteFromTree(value);
+        if (this->rebalancing && 3 * this->count < 2 * this->maxCount) { // a third gone since the last full rebuild
+            if (this->root != nullptr) {
+                rebuild(this->root, this->count);
+            }
+            this->maxCount = this->count;
+        }
+        return this->count != before;
+    }
+
     // destructor helper
 
     //-------------------------------------------------------
     // Name: destroy(Node*& p)
-    // PreCondition:  root node p given
-    // PostCondition: Deletes node p and its children recursively
+    // PreCondition:  root node p of the tree given
+    // PostCondition: Deletes node p and its children, handing the allocator back in whole slabs when it can
     //---------------------------------------------------------
     void destroy(Node*& p) {
-        if (p != nullptr) {
-            destroy(p->left);
-            destroy(p->right);
-            delete p;
+        if (!NodeAllocator<Node>::RELEASES_ALL || !std::is_trivially_destructible<Comparable>::value) {
+            destroyNodes(p);
+        }
+        this->allocator.release();
+        p = nullptr;
+        this->count = 0;
+        this->maxCount = 0;
+    }
+
+    //-------------------------------------------------------
+    // Name: destroyNodes(Node* p)
+    // PreCondition:  node p given
+    // PostCondition: destroys node p and its children, freeing them one at a time unless the allocator releases all.
+    //                Walks down to a leaf and back up through parent pointers, so deep trees can't overflow the stack.
+    //---------------------------------------------------------
+    void destroyNodes(Node* p) {
+        Node* top = (p == nullptr) ? nullptr : p->parent; // stop once back above p
+        while (p != top) {
+            if (p->left != nullptr) {
+                p = p->left;
+            }
+            else if (p->right != nullptr) {
+                p = p->right;
+            }
+            else { // leaf, unhook it from its parent and destroy it
+                Node* parent = p->parent;
+                if (parent != top) {
+                    if (parent->left == p) {
+                        parent->left = nullptr;
+                    }
+                    else {
+                        parent->right = nullptr;
+                    }
+                }
+                if (NodeAllocator<Node>::RELEASES_ALL) {
+                    p->~Node();
+                }
+                else {
+                    destroyNode(p);
+                }
+                p = parent;
+            }
         }
-        return;
     }
 
     // copy constructor and assignment operator helper
@@ -92,41 +445,188 @@ private:
     //-------------------------------------------------------
     // Name: copyNode(Node* n)
     // PreCondition:  root node n given
-    // PostCondition: Deep copys root node n and children recursively and returns a copy of node n connected to its children
+    // PostCondition: Deep copys root node n and children and returns a copy of node n connected to its children.
+    //                Walks both trees together through parent pointers, so deep trees can't overflow the stack.
     //---------------------------------------------------------
     Node* copyNode(Node* n) { // helper
-        Node* c = new Node;
-        c->data = n->data;
-        if (n->left != nullptr) { // copy left child
-            c->left = copyNode(n->left);
+        if (n == nullptr) { // copying an empty tree
+            return nullptr;
         }
-        if (n->right != nullptr) { // copy right child
-            c->right = copyNode(n->right);
+        Node* top = createNode(n->data);
+        Node* c = top; // copy of n
+        while (true) {
+            if (n->left != nullptr && c->left == nullptr) { // copy left child
+                c->left = createNode(n->left->data);
+                c->left->parent = c;
+                n = n->left;
+                c = c->left;
+            }
+            else if (n->right != nullptr && c->right == nullptr) { // copy right child
+                c->right = createNode(n->right->data);
+                c->right->parent = c;
+                n = n->right;
+                c = c->right;
+            }
+            else if (c == top) { // both sides of the root are done
+                return top;
+            }
+            else { // both sides done, back up
+                n = n->parent;
+                c = c->parent;
+            }
         }
-        return c;
     }
 
-    // print_tree() helper
+    // range constructor and assign() helper
 
     //-------------------------------------------------------
-    // Name: printTreeLine(Node* p, int space, std::ostream& os=std::cout)
-    // PreCondition:  root Node p given with value for space, and an ostream os that defaults to cout
-    // PostCondition: recursively prints tree rotated to os 90 degrees from root node p
+    // Name: buildTree(RandomIt first, std::size_t n)
+    // PreCondition:  n strictly increasing values starting at first
+    // PostCondition: returns the root of a perfectly balanced tree of the n values, in O(n)
     //---------------------------------------------------------
-    void printTreeLine(Node* p, int space, std::ostream& os=std::cout) const {
-        if (p == nullptr) {
-            return;
+    template <typename RandomIt>
+    Node* buildTree(RandomIt first, std::size_t n) {
+        if (n == 0) {
+            return nullptr;
+        }
+        std::size_t mid = n / 2; // middle value becomes the root
+        Node* p = createNode(first[mid]);
+        p->left = buildTree(first, mid);
+        p->right = buildTree(first + mid + 1, n - mid - 1);
+        if (p->left != nullptr) {
+            p->left->parent = p;
         }
-        space++; // number of levels 
-        printTreeLine(p->right, space, os);
-        for (int i = 1; i < space; i++) {
-            os << "  "; // adds number of spaces
+        if (p->right != nullptr) {
+            p->right->parent = p;
         }
-        os << p->data << endl;
-        printTreeLine(p->left, space, os);
-        return;
+        return p;
+    }
+
+    //-------------------------------------------------------
+    // Name: isStrictlySorted(RandomIt first, RandomIt last)
+    // PreCondition:  range first to last given
+    // PostCondition: returns true if every value is less than the one after it
+    //---------------------------------------------------------
+    template <typename RandomIt>
+    bool isStrictlySorted(RandomIt first, RandomIt last) const {
+        return std::adjacent_find(first, last, [this](const Comparable& a, const Comparable& b) {
+            return !this->comp(a, b);
+        }) == last;
     }
 
+    // iterator helpers
+
+    //-------------------------------------------------------
+    // Name: successor(const Node* n)
+    // PreCondition:  node n given
+    // PostCondition: returns the node after n in order, or nullptr if n holds the maximum
+    //---------------------------------------------------------
+    static const Node* successor(const Node* n) {
+        if (n->right != nullptr) { // leftmost node of the right subtree
+            n = n->right;
+            while (n->left != nullptr) {
+                n = n->left;
+            }
+            return n;
+        }
+        while (n->parent != nullptr && n->parent->right == n) { // climb out of right subtrees
+            n = n->parent;
+        }
+        return n->parent;
+    }
+
+    //-------------------------------------------------------
+    // Name: predecessor(const Node* n)
+    // PreCondition:  node n given
+    // PostCondition: returns the node before n in order, or nullptr if n holds the minimum
+    //---------------------------------------------------------
+    static const Node* predecessor(const Node* n) {
+        if (n->left != nullptr) { // rightmost node of the left subtree
+            n = n->left;
+            while (n->right != nullptr) {
+                n = n->right;
+            }
+            return n;
+        }
+        while (n->parent != nullptr && n->parent->left == n) { // climb out of left subtrees
+            n = n->parent;
+        }
+        return n->parent;
+    }
+
+public:
+    //-------------------------------------------------------
+    // Name: const_iterator
+    // Description: bidirectional in-order iterator over the values of the tree. Steps follow
+    //              parent pointers, so a full scan is amortized O(1) per value and never allocates.
+    //---------------------------------------------------------
+    class const_iterator {
+    private:
+        const Node* node; // current node, nullptr once past the end
+        const BinarySearchTree* tree; // tree walked, needed to step back from end()
+
+        const_iterator(const Node* node, const BinarySearchTree* tree) : node(node), tree(tree) {}
+        friend class BinarySearchTree;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = Comparable;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Comparable*;
+        using reference = const Comparable&;
+
+        const_iterator() : node(nullptr), tree(nullptr) {}
+
+        reference operator*() const { return this->node->data; }
+        pointer operator->() const { return &this->node->data; }
+
+        const_iterator& operator++() {
+            this->node = successor(this->node);
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++(*this);
+            return old;
+        }
+
+        const_iterator& operator--() {
+            if (this->node == nullptr) { // end() steps back to the maximum
+                const Node* n = this->tree->root;
+                while (n->right != nullptr) {
+                    n = n->right;
+                }
+                this->node = n;
+            }
+            else {
+                this->node = predecessor(this->node);
+            }
+            return *this;
+        }
+
+        const_iterator operator--(int) {
+            const_iterator old = *this;
+            --(*this);
+            return old;
+        }
+
+        bool operator==(const const_iterator& rhs) const { return this->node == rhs.node; }
+        bool operator!=(const const_iterator& rhs) const { return this->node != rhs.node; }
+    };
+
+    // values are kept in order by the tree, so they can only be read through an iterator
+    using iterator = const_iterator;
+    using key_compare = Compare;
+
+private:
+    //-------------------------------------------------------
+    // Name: iteratorTo(const Node* n)
+    // PreCondition:  node n of the tree, or nullptr for end()
+    // PostCondition: returns an iterator to n
+    //---------------------------------------------------------
+    const_iterator iteratorTo(const Node* n) const { return const_iterator(n, this); }
+
 public:
     // constructors 
 
@@ -137,13 +637,48 @@ public:
     //---------------------------------------------------------
     BinarySearchTree():root(nullptr) {}
 
+    //-------------------------------------------------------
+    // Name: BinarySearchTree(const Compare& comp)
+    // PreCondition: comparator comp given
+    // PostCondition: creates new empty BinarySearchTree that orders its values with comp
+    //---------------------------------------------------------
+    explicit BinarySearchTree(const Compare& comp) : root(nullptr), comp(comp) {}
+
     //-------------------------------------------------------
     // Name: BinarySearchTree(const BinarySearchTree& other)
     // PreCondition: BinarySearchTree other passed by reference
     // PostCondition: creates new object BinarySearchTree that is a deep copy of other
     //---------------------------------------------------------
-    BinarySearchTree(const BinarySearchTree& other) {
+    BinarySearchTree(const BinarySearchTree& other) : comp(other.comp) {
         this->root = copyNode(other.root);
+        this->count = other.count;
+        this->maxCount = other.count;
+        this->rebalancing = other.rebalancing;
+    }
+
+    //-------------------------------------------------------
+    // Name: BinarySearchTree(BinarySearchTree&& other)
+    // PreCondition: BinarySearchTree other passed as an rvalue
+    // PostCondition: creates new object BinarySearchTree that takes over the nodes of other, leaving other empty.
+    //                Never throws unless copying the comparator can, so containers of trees move them instead of copying.
+    //---------------------------------------------------------
+    BinarySearchTree(BinarySearchTree&& other) noexcept(std::is_nothrow_copy_constructible<Compare>::value)
+        : root(other.root), comp(other.comp) {
+        other.root = nullptr;
+        this->allocator.swap(other.allocator);
+        std::swap(this->count, other.count);
+        std::swap(this->maxCount, other.maxCount);
+        this->rebalancing = other.rebalancing;
+    }
+
+    //-------------------------------------------------------
+    // Name: BinarySearchTree(InputIt first, InputIt last, const Compare& comp = Compare())
+    // PreCondition: range of values first to last given, and a comparator comp if not the default one
+    // PostCondition: creates new BinarySearchTree object holding the values of the range in the order of comp, see assign()
+    //---------------------------------------------------------
+    template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    BinarySearchTree(InputIt first, InputIt last, const Compare& comp = Compare()) : root(nullptr), comp(comp) {
+        assign(first, last);
     }
 
     // destructor
@@ -168,15 +703,66 @@ public:
     //---------------------------------------------------------
     BinarySearchTree& operator=(const BinarySearchTree& other) {
         if (this != &other) { // checking not the same object
-            if (this->root != nullptr) { // emptying object if not empty
-                destroy(this->root);
-                this->root = nullptr;
-            }
+            destroy(this->root); // emptying object
+            this->comp = other.comp;
             this->root = copyNode(other.root);
+            this->count = other.count;
+            this->maxCount = other.count;
+            this->rebalancing = other.rebalancing;
         }
         return *this;
     }
 
+    //-------------------------------------------------------
+    // Name: operator=(BinarySearchTree&& other)
+    // PreCondition: BinarySearchTree other passed as an rvalue
+    // PostCondition: frees this tree and takes over the nodes of other, leaving other empty
+    //---------------------------------------------------------
+    BinarySearchTree& operator=(BinarySearchTree&& other) noexcept(std::is_nothrow_copy_assignable<Compare>::value) {
+        if (this != &other) { // checking not the same object
+            destroy(this->root);
+            std::swap(this->root, other.root);
+            this->comp = other.comp;
+            this->allocator.swap(other.allocator);
+            std::swap(this->count, other.count);
+            std::swap(this->maxCount, other.maxCount);
+            this->rebalancing = other.rebalancing;
+        }
+        return *this;
+    }
+
+    //-------------------------------------------------------
+    // Name: assign(InputIt first, InputIt last)
+    // PreCondition: range of values first to last given
+    // PostCondition: replaces the tree with a perfectly balanced one holding the values of the range.
+    //                Strictly sorted random access input is built in O(n) straight from the range,
+    //                anything else is copied, sorted and deduplicated first.
+    //---------------------------------------------------------
+    template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    void assign(InputIt first, InputIt last) {
+        make_empty();
+        if constexpr (std::is_base_of<std::random_access_iterator_tag,
+                                      typename std::iterator_traits<InputIt>::iterator_category>::value) {
+            if (isStrictlySorted(first, last)) { // no copy needed
+                this->count = static_cast<std::size_t>(last - first);
+                this->maxCount = this->count;
+                this->root = buildTree(first, this->count);
+                return;
+            }
+        }
+
+        std::vector<Comparable> values(first, last);
+        if (!std::is_sorted(values.begin(), values.end(), this->comp)) {
+            std::sort(values.begin(), values.end(), this->comp);
+        }
+        values.erase(std::unique(values.begin(), values.end(), [this](const Comparable& a, const Comparable& b) {
+            return !this->comp(a, b); // sorted, so a is not after b
+        }), values.end());
+        this->count = values.size();
+        this->maxCount = this->count;
+        this->root = buildTree(std::make_move_iterator(values.begin()), values.size());
+    }
+
     //-------------------------------------------------------
     // Name: contains(const Comparable& value)
     // PreCondition: Comparable value passed by reference
@@ -190,10 +776,11 @@ public:
         Node* current = this->root;
 
         while (current != nullptr) { // traverse tree
-            if (current->data == value) { // nodes data is value
+            int c = three_way(this->comp, value, current->data); // one comparison per level
+            if (c == 0) { // nodes data is value
                 return true;
             }
-            else if (current->data > value) {
+            else if (c < 0) {
                 current = current->left;
             }
             else {
@@ -206,44 +793,101 @@ public:
     }
 
     //-------------------------------------------------------
-    // Name: insert(const Comparable& value)
+    // Name: contains(const Key& key)
+    // PreCondition: key that Compare can compare with the values, only when Compare is transparent like std::less<>
+    // PostCondition: return true if a value equivalent to key is in the tree, without building a Comparable from key,
+    //                so a std::string_view looks up std::string values without a copy
+    //---------------------------------------------------------
+    template <typename Key, typename C = Compare, typename = typename C::is_transparent>
+    bool contains(const Key& key) const {
+        return findNode(key) != nullptr;
+    }
+
+    //-------------------------------------------------------
+    // Name: find(const Comparable& value)
     // PreCondition: Comparable value passed by reference
-    // PostCondition: creates a node with value as its data and puts it into tree
+    // PostCondition: returns an iterator to value in the tree, end() if it is not there
     //---------------------------------------------------------
-    void insert(const Comparable& value) {
-        if (contains(value)) { // value in tree already
-            return;
-        }
+    const_iterator find(const Comparable& value) const {
+        return const_iterator(findNode(value), this);
+    }
 
-        Node* item = new Node;
-        item->data = value;
+    //-------------------------------------------------------
+    // Name: find(const Key& key)
+    // PreCondition: key that Compare can compare with the values, only when Compare is transparent like std::less<>
+    // PostCondition: returns an iterator to the value equivalent to key, end() if there is none,
+    //                without building a Comparable from key
+    //---------------------------------------------------------
+    template <typename Key, typename C = Compare, typename = typename C::is_transparent>
+    const_iterator find(const Key& key) const {
+        return const_iterator(findNode(key), this);
+    }
 
-        Node* current;
-        Node* trailCurrent;
-        
-        if (this->root == nullptr) { // tree is empty, becomes root
-            this->root = item;
-            return;
-        }
+    //-------------------------------------------------------
+    // Name: insert(const Comparable& value)
+    // PreCondition: Comparable value passed by reference
+    // PostCondition: creates a node with value as its data and puts it into tree.
+    //                Returns an iterator to value in the tree and whether it was inserted, in one walk down.
+    //---------------------------------------------------------
+    std::pair<const_iterator, bool> insert(const Comparable& value) {
+        Node* parent;
+        Node** link = findSlot(value, parent);
+        return {const_iterator(insertAt(link, parent, value), this), link != nullptr};
+    }
 
-        current = this->root;
-        while (current != nullptr) {
-            trailCurrent = current; // parent of current
+    //-------------------------------------------------------
+    // Name: insert(Comparable&& value)
+    // PreCondition: Comparable value passed as an rvalue
+    // PostCondition: moves value into a new node and puts it into tree.
+    //                Returns an iterator to value in the tree and whether it was inserted.
+    //---------------------------------------------------------
+    std::pair<const_iterator, bool> insert(Comparable&& value) {
+        Node* parent;
+        Node** link = findSlot(value, parent);
+        return {const_iterator(insertAt(link, parent, std::move(value)), this), link != nullptr};
+    }
 
-            if (current->data > value) { // shift to left
-                current = current->left;
-            }
-            else { // shift to right
-                current = current->right;
-            }
-        }
+    //-------------------------------------------------------
+    // Name: insert(const_iterator hint, const Comparable& value)
+    // PreCondition: iterator hint to the value that will follow value, or end() if value goes last
+    // PostCondition: inserts value like insert(value) and returns an iterator to it.
+    //                With a correct hint the walk down from the root is skipped.
+    //---------------------------------------------------------
+    const_iterator insert(const_iterator hint, const Comparable& value) {
+        Node* parent;
+        Node** link = hintSlot(hint.node, value, parent);
+        return const_iterator(insertAt(link, parent, value), this);
+    }
 
-        if (trailCurrent->data > value) { // add to left child
-            trailCurrent->left = item;
-        }
-        else { // add to right child
-            trailCurrent->right = item;
+    //-------------------------------------------------------
+    // Name: insert(const_iterator hint, Comparable&& value)
+    // PreCondition: iterator hint to the value that will follow value, or end() if value goes last
+    // PostCondition: moves value into the tree like insert(hint, const Comparable&) and returns an iterator to it
+    //---------------------------------------------------------
+    const_iterator insert(const_iterator hint, Comparable&& value) {
+        Node* parent;
+        Node** link = hintSlot(hint.node, value, parent);
+        return const_iterator(insertAt(link, parent, std::move(value)), this);
+    }
+
+    //-------------------------------------------------------
+    // Name: emplace(Args&&... args)
+    // PreCondition: arguments for a Comparable constructor given
+    // PostCondition: builds the value in place inside a new node and puts it into tree.
+    //                The node is freed again if an equal value is already there.
+    //                Returns an iterator to the value in the tree and whether it was inserted.
+    //---------------------------------------------------------
+    template <typename... Args>
+    std::pair<const_iterator, bool> emplace(Args&&... args) {
+        Node* item = createNode(std::forward<Args>(args)...);
+        Node* parent;
+        Node** link = findSlot(item->data, parent);
+        if (link == nullptr) { // value in tree already, parent holds it
+            destroyNode(item);
+            return {const_iterator(parent, this), false};
         }
+        addNode(item, parent, link);
+        return {const_iterator(item, this), true};
     }
 
     //-------------------------------------------------------
@@ -252,7 +896,7 @@ public:
     // PostCondition: removes a node with value from tree
     //---------------------------------------------------------
     void remove(const Comparable& value) {
-        deleteFromTree(value, this->root);
+        removeKey(value);
     }
 
     //-------------------------------------------------------
@@ -287,6 +931,99 @@ public:
         return current->data;
     }
 
+    //-------------------------------------------------------
+    // Name: begin()
+    // PreCondition: none
+    // PostCondition: returns an iterator to the minimum value, or end() if the tree is empty
+    //---------------------------------------------------------
+    const_iterator begin() const {
+        const Node* current = this->root;
+        if (current != nullptr) {
+            while (current->left != nullptr) { // get to leftmost node
+                current = current->left;
+            }
+        }
+        return const_iterator(current, this);
+    }
+
+    //-------------------------------------------------------
+    // Name: end()
+    // PreCondition: none
+    // PostCondition: returns the iterator one past the maximum value
+    //---------------------------------------------------------
+    const_iterator end() const { return const_iterator(nullptr, this); }
+
+    //-------------------------------------------------------
+    // Name: lower_bound(const Comparable& value)
+    // PreCondition: Comparable value passed by reference
+    // PostCondition: returns an iterator to the first value not less than value, or end()
+    //---------------------------------------------------------
+    const_iterator lower_bound(const Comparable& value) const {
+        const Node* found = nullptr;
+        const Node* current = this->root;
+        while (current != nullptr) {
+            if (this->comp(current->data, value)) { // too small, shift right
+                current = current->right;
+            }
+            else { // candidate, look for a smaller one on the left
+                found = current;
+                current = current->left;
+            }
+        }
+        return const_iterator(found, this);
+    }
+
+    //-------------------------------------------------------
+    // Name: upper_bound(const Comparable& value)
+    // PreCondition: Comparable value passed by reference
+    // PostCondition: returns an iterator to the first value greater than value, or end()
+    //---------------------------------------------------------
+    const_iterator upper_bound(const Comparable& value) const {
+        const Node* found = nullptr;
+        const Node* current = this->root;
+        while (current != nullptr) {
+            if (this->comp(value, current->data)) { // candidate, look for a smaller one on the left
+                found = current;
+                current = current->left;
+            }
+            else { // too small, shift right
+                current = current->right;
+            }
+        }
+        return const_iterator(found, this);
+    }
+
+    //-------------------------------------------------------
+    // Name: freeze()
+    // PreCondition: none
+    // PostCondition: returns a read-only copy of the values laid out in one array for fast searches, see frozen_tree.h
+    //---------------------------------------------------------
+    FrozenTree<Comparable, Compare> freeze() const {
+        return FrozenTree<Comparable, Compare>(begin(), end(), this->comp);
+    }
+
+    //-------------------------------------------------------
+    // Name: save(const std::string& path)
+    // PreCondition: path of the file to write, Comparable trivially copyable
+    // PostCondition: writes the values in order to path as a tree file for load() or MappedTree, see tree_file.h.
+    //                Throws std::runtime_error if the file cannot be written.
+    //---------------------------------------------------------
+    void save(const std::string& path) const {
+        write_tree_file<Comparable>(path, begin(), size());
+    }
+
+    //-------------------------------------------------------
+    // Name: load(const std::string& path)
+    // PreCondition: path of a tree file of Comparable values, saved in the order of this tree's comparator
+    // PostCondition: replaces the tree with a perfectly balanced one holding the saved values, built in O(n)
+    //                with no comparisons besides checking the order. Throws std::runtime_error and leaves
+    //                the tree as it was if the file cannot be read.
+    //---------------------------------------------------------
+    void load(const std::string& path) {
+        std::vector<Comparable> values = read_tree_file<Comparable>(path);
+        assign(values.begin(), values.end());
+    }
+
     //-------------------------------------------------------
     // Name: print_tree(std::ostream& os=std::cout)
     // PreCondition: ostream os defaults to cout if none given
@@ -294,13 +1031,64 @@ public:
     //---------------------------------------------------------
     void print_tree(std::ostream& os=std::cout) const {
         if (!is_empty()) {
-            this->printTreeLine(this->root, 0, os);
+            write_tree(os, this->root, TreeFormat::Rotated, NO_DEPTH_LIMIT);
         }
         else { // empty tree
             os << "<empty>\n";
         }
     }
 
+    //-------------------------------------------------------
+    // Name: export_tree(std::ostream& os, TreeFormat format, std::size_t max_depth = NO_DEPTH_LIMIT)
+    // PreCondition: ostream os, format to write in, and the deepest level to write, the root being at 0
+    // PostCondition: writes the tree to os as Graphviz DOT, JSON, one line per level or rotated like print_tree(),
+    //                leaving out nodes deeper than max_depth, see tree_print.h
+    //---------------------------------------------------------
+    void export_tree(std::ostream& os, TreeFormat format, std::size_t max_depth = NO_DEPTH_LIMIT) const {
+        write_tree(os, this->root, format, max_depth);
+    }
+
+    //-------------------------------------------------------
+    // Name: set_rebalancing(bool enabled)
+    // PreCondition: enabled given
+    // PostCondition: turns rebalancing on or off. While on, the tree is rebuilt scapegoat style: an insert that lands
+    //                deeper than log base 3/2 of size() rebuilds the subtree of an ancestor holding a lopsided share of
+    //                it, and removing a third of the values rebuilds the whole tree, keeping insert, remove and
+    //                contains O(log n) amortized even on sorted input. Turning it on rebuilds the tree once.
+    //---------------------------------------------------------
+    void set_rebalancing(bool enabled) {
+        this->rebalancing = enabled;
+        if (enabled && this->root != nullptr) {
+            rebuild(this->root, this->count);
+        }
+        this->maxCount = this->count;
+    }
+
+    //-------------------------------------------------------
+    // Name: is_rebalancing()
+    // PreCondition: none
+    // PostCondition: returns true if the tree rebuilds itself to stay balanced, see set_rebalancing()
+    //---------------------------------------------------------
+    bool is_rebalancing() const {
+        return this->rebalancing;
+    }
+
+    //-------------------------------------------------------
+    // Name: key_comp()
+    // PreCondition: none
+    // PostCondition: returns the comparator that orders the values
+    //---------------------------------------------------------
+    Compare key_comp() const { return this->comp; }
+
+    //-------------------------------------------------------
+    // Name: size()
+    // PreCondition: none
+    // PostCondition: returns the number of values in the tree
+    //---------------------------------------------------------
+    std::size_t size() const {
+        return this->count;
+    }
+
     //-------------------------------------------------------
     // Name: is_empty()
     // PreCondition: none
@@ -319,12 +1107,6 @@ public:
         destroy(this->root);
         this->root = nullptr;
     }
-
-
-    // optional
-    // BinarySearchTree(BinarySearchTree&& other);
-    // BinarySearchTree& operator=(BinarySearchTree&& other);
-    // void insert(Comparable&& value);
 };
 
 #endif
@@ -7,7 +7,16 @@
 ** E-mail:  naimurrah01@tamu.edu
 ** Description: Tests for BinarySearchTree class
 **/
+#include <algorithm>
+#include <cstdio>
+#include <functional>
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <pthread.h>
 #include "binary_search_tree.h"
 using std::cout, std::endl;
 int main() {
@@ -190,4 +199,268 @@ int main() {
     cbst.print_tree();
     cout << "Min val: should be a: " << cbst.find_min() << endl;
     cout << "Max val: should be z: " << cbst.find_max() << endl;
+
+    // allocator tests
+    cout << endl;
+    BinarySearchTree<int, HeapAllocator> heap;
+    for (int i = 0; i < 100; i++) {
+        heap.insert((i * 37) % 100);
+    }
+    for (int i = 0; i < 100; i += 2) {
+        heap.remove(i);
+    }
+    cout << "Heap allocator min: should be 1: " << heap.find_min() << endl;
+    cout << "Heap allocator max: should be 99: " << heap.find_max() << endl;
+    cout << "Heap allocator contains 50: should be 0: " << heap.contains(50) << endl;
+
+    BinarySearchTree<int> pooled;
+    for (int i = 0; i < 1000; i++) {
+        pooled.insert((i * 7919) % 1000);
+    }
+    for (int i = 0; i < 1000; i += 3) { // freed nodes go back on the free list
+        pooled.remove(i);
+    }
+    for (int i = 0; i < 1000; i += 3) { // and come back off it
+        pooled.insert(i);
+    }
+    cout << "Pool min: should be 0: " << pooled.find_min() << endl;
+    cout << "Pool max: should be 999: " << pooled.find_max() << endl;
+    cout << "Pool contains 333: should be 1: " << pooled.contains(333) << endl;
+    pooled.make_empty();
+    cout << "Pool empty after make_empty: should be 1: " << pooled.is_empty() << endl;
+    pooled.insert(5);
+    cout << "Pool reused after make_empty, min: should be 5: " << pooled.find_min() << endl;
+
+    BinarySearchTree<std::string> strings; // keys that need their destructors run
+    strings.insert("pear");
+    strings.insert("apple");
+    strings.insert("fig");
+    strings.remove("pear");
+    BinarySearchTree<std::string> stringsCopy(strings);
+    strings.make_empty();
+    cout << "String copy min: should be apple: " << stringsCopy.find_min() << endl;
+    cout << "String copy max: should be fig: " << stringsCopy.find_max() << endl;
+
+    // range constructor tests
+    cout << endl;
+    std::vector<int> sorted = {1, 2, 3, 4, 5, 6, 7};
+    BinarySearchTree<int> built(sorted.begin(), sorted.end());
+    cout << "Built from sorted 1..7, balanced with 4 as root:" << endl;
+    built.print_tree();
+    cout << "Built min: should be 1: " << built.find_min() << endl;
+    cout << "Built max: should be 7: " << built.find_max() << endl;
+
+    std::vector<int> unsorted = {5, 3, 9, 3, 1, 7, 5};
+    built.assign(unsorted.begin(), unsorted.end());
+    cout << "Assigned from unsorted with duplicates, holds 1 3 5 7 9:" << endl;
+    built.print_tree();
+    cout << "Built contains 4: should be 0: " << built.contains(4) << endl;
+    cout << "Built contains 9: should be 1: " << built.contains(9) << endl;
+
+    built.assign(sorted.begin(), sorted.begin());
+    cout << "Assigned from empty range, empty: should be 1: " << built.is_empty() << endl;
+
+    // iterator tests
+    cout << endl;
+    BinarySearchTree<int> ordered;
+    for (int v : {50, 20, 80, 10, 30, 70, 90, 60}) {
+        ordered.insert(v);
+    }
+    cout << "In order: should be 10 20 30 50 60 70 80 90: ";
+    for (int v : ordered) {
+        cout << v << ' ';
+    }
+    cout << endl;
+    cout << "Reverse: should be 90 80 70 60 50 30 20 10: ";
+    for (BinarySearchTree<int>::const_iterator it = ordered.end(); it != ordered.begin();) {
+        --it;
+        cout << *it << ' ';
+    }
+    cout << endl;
+    cout << "lower_bound(55): should be 60: " << *ordered.lower_bound(55) << endl;
+    cout << "lower_bound(60): should be 60: " << *ordered.lower_bound(60) << endl;
+    cout << "upper_bound(60): should be 70: " << *ordered.upper_bound(60) << endl;
+    cout << "upper_bound(90) is end: should be 1: " << (ordered.upper_bound(90) == ordered.end()) << endl;
+    cout << "lower_bound(5) is begin: should be 1: " << (ordered.lower_bound(5) == ordered.begin()) << endl;
+    ordered.remove(50);
+    cout << "In order after removing 50: should be 10 20 30 60 70 80 90: ";
+    for (BinarySearchTree<int>::const_iterator it = ordered.begin(); it != ordered.end(); it++) {
+        cout << *it << ' ';
+    }
+    cout << endl;
+    BinarySearchTree<int> none;
+    cout << "Empty tree begin is end: should be 1: " << (none.begin() == none.end()) << endl;
+
+    // move and emplace tests
+    cout << endl;
+    BinarySearchTree<std::string> words;
+    std::string pear = "pear";
+    words.insert(std::move(pear));
+    words.emplace(5, 'z'); // "zzzzz" built inside the node
+    words.emplace("apple");
+    words.emplace("pear"); // already there
+    cout << "Words min: should be apple: " << words.find_min() << endl;
+    cout << "Words max: should be zzzzz: " << words.find_max() << endl;
+    cout << "Contains pear: should be 1: " << words.contains("pear") << endl;
+
+    BinarySearchTree<std::string> moved(std::move(words));
+    cout << "Moved from tree empty: should be 1: " << words.is_empty() << endl;
+    cout << "Moved to tree min: should be apple: " << moved.find_min() << endl;
+    words.insert("reused");
+    cout << "Moved from tree reused, min: should be reused: " << words.find_min() << endl;
+
+    words = std::move(moved);
+    cout << "Move assigned tree min: should be apple: " << words.find_min() << endl;
+    cout << "Move assigned from tree empty: should be 1: " << moved.is_empty() << endl;
+    static_assert(std::is_nothrow_move_constructible<BinarySearchTree<int>>::value, "containers of trees move them");
+    static_assert(std::is_nothrow_move_assignable<BinarySearchTree<int>>::value, "containers of trees move them");
+    std::vector<BinarySearchTree<std::string>> forest(1);
+    forest[0].insert("kept");
+    const std::string* kept = &*forest[0].begin();
+    for (int i = 0; i < 100; i++) { // reallocates a few times
+        forest.emplace_back();
+    }
+    cout << "Tree moved, not copied, when a vector grows: should be 1: " << (&*forest[0].begin() == kept) << endl;
+
+    // rebalancing tests
+    cout << endl;
+    BinarySearchTree<int> ingest;
+    ingest.set_rebalancing(true);
+    for (int i = 1; i <= 7; i++) { // sorted input would make a list of 7 levels
+        ingest.insert(i);
+    }
+    cout << "Rebalancing: should be 1: " << ingest.is_rebalancing() << endl;
+    cout << "Size after sorted inserts: should be 7: " << ingest.size() << endl;
+    ingest.print_tree();
+    cout << "In order: should be 1 2 3 4 5 6 7: ";
+    for (int v : ingest) {
+        cout << v << ' ';
+    }
+    cout << endl;
+    for (int i = 1; i <= 4; i++) {
+        ingest.remove(i);
+    }
+    cout << "Size after removes: should be 3: " << ingest.size() << endl;
+    ingest.print_tree();
+
+    BinarySearchTree<int> chain;
+    for (int i = 1; i <= 5; i++) {
+        chain.insert(i);
+    }
+    chain.set_rebalancing(true); // rebuilds the chain right away
+    chain.print_tree();
+    BinarySearchTree<int> chainCopy(chain);
+    cout << "Copy keeps rebalancing: should be 1: " << chainCopy.is_rebalancing() << endl;
+    cout << "Copy size: should be 5: " << chainCopy.size() << endl;
+    BinarySearchTree<int> deep; // rebalancing off, so this stays a list 10000 nodes deep
+    deep.insert(0);
+    deep.insert(-1);
+    for (int i = 10000; i >= 1; i--) { // down the left side of 10000, so 1 is deepest
+        deep.insert(i);
+    }
+    // removed on a thread with a 64 KiB stack, far less than one call per level would take
+    pthread_attr_t smallStack;
+    pthread_attr_init(&smallStack);
+    pthread_attr_setstacksize(&smallStack, 65536);
+    pthread_t remover;
+    pthread_create(&remover, &smallStack, [](void* tree) -> void* {
+        BinarySearchTree<int>& t = *static_cast<BinarySearchTree<int>*>(tree);
+        t.remove(1); // deepest key, at the bottom of the list
+        t.remove(0); // two children, the successor 2 is at the bottom of the list
+        return nullptr;
+    }, &deep);
+    pthread_join(remover, nullptr);
+    pthread_attr_destroy(&smallStack);
+    cout << "Removed deepest, contains 1: should be 0: " << deep.contains(1) << endl;
+    cout << "Removed root, contains 0: should be 0: " << deep.contains(0) << endl;
+    cout << "Size after removing from a list: should be 10000: " << deep.size() << endl;
+    cout << "Min after removing from a list: should be -1: " << deep.find_min() << endl;
+    cout << endl;
+
+    // insert result and hint tests
+    BinarySearchTree<int> hinted;
+    std::pair<BinarySearchTree<int>::iterator, bool> result = hinted.insert(20);
+    cout << "First insert inserted: should be 1: " << result.second << endl;
+    cout << "First insert iterator: should be 20: " << *result.first << endl;
+    result = hinted.insert(20);
+    cout << "Duplicate insert inserted: should be 0: " << result.second << endl;
+    cout << "Duplicate insert iterator: should be 20: " << *result.first << endl;
+    result = hinted.emplace(10);
+    cout << "Emplace inserted: should be 1: " << result.second << endl;
+    for (int i = 30; i <= 60; i += 10) { // sorted input, the end is always the right hint
+        hinted.insert(hinted.end(), i);
+    }
+    BinarySearchTree<int>::iterator at = hinted.insert(hinted.lower_bound(40), 35);
+    cout << "Hinted insert iterator: should be 35: " << *at << endl;
+    at = hinted.insert(hinted.begin(), 55); // wrong hint still inserts
+    cout << "Wrong hint iterator: should be 55: " << *at << endl;
+    at = hinted.insert(hinted.end(), 30); // already there
+    cout << "Duplicate hint iterator: should be 30: " << *at << endl;
+    cout << "In order: should be 10 20 30 35 40 50 55 60: ";
+    for (int v : hinted) {
+        cout << v << ' ';
+    }
+    cout << endl;
+    cout << "Size: should be 8: " << hinted.size() << endl;
+    cout << endl;
+
+    // comparator tests
+    BinarySearchTree<int, NodePool, std::greater<int>> down;
+    int downValues[] = {5, 8, 2, 9, 1};
+    for (int v : downValues) {
+        down.insert(v);
+    }
+    down.remove(8);
+    cout << "Greater first: should be 9 5 2 1: ";
+    for (int v : down) {
+        cout << v << ' ';
+    }
+    cout << endl;
+    cout << "Contains 2: should be 1: " << down.contains(2) << endl;
+    cout << "upper_bound(5): should be 2: " << *down.upper_bound(5) << endl;
+    BinarySearchTree<std::string, NodePool, std::less<>> names;
+    names.insert("b");
+    names.insert("a");
+    cout << "Contains string_view a: should be 1: " << names.contains(std::string_view("a")) << endl;
+    cout << "Find string_view c is end: should be 1: " << (names.find(std::string_view("c")) == names.end()) << endl;
+    cout << endl;
+
+    // save and load tests
+    BinarySearchTree<int> saved;
+    for (int i = 0; i < 1000; i++) {
+        saved.insert(i); // a list, but loaded back balanced
+    }
+    saved.save("binary_search_tree_tests.tree");
+    BinarySearchTree<int> loaded;
+    loaded.load("binary_search_tree_tests.tree");
+    cout << "Loaded size: should be 1000: " << loaded.size() << endl;
+    cout << "Loaded min: should be 0: " << loaded.find_min() << endl;
+    cout << "Loaded max: should be 999: " << loaded.find_max() << endl;
+    cout << "Loaded contains 500: should be 1: " << loaded.contains(500) << endl;
+    cout << "Loaded same as saved: should be 1: " << std::equal(loaded.begin(), loaded.end(), saved.begin(), saved.end()) << endl;
+    try {
+        BinarySearchTree<char> wrongType;
+        wrongType.load("binary_search_tree_tests.tree");
+    }
+    catch (const std::runtime_error&) {
+        cout << "Load of int file into char tree failed: success" << endl;
+    }
+    std::remove("binary_search_tree_tests.tree");
+    cout << endl;
+
+    // export tests
+    std::ostringstream list;
+    saved.export_tree(list, TreeFormat::Rotated); // 1000 levels deep, written without recursing
+    std::string listText = list.str();
+    cout << "Lines for list of 1000: should be 1000: " << std::count(listText.begin(), listText.end(), '\n') << endl;
+    std::ostringstream levels;
+    saved.export_tree(levels, TreeFormat::LevelOrder, 2);
+    cout << "Level order of list to depth 2 right: should be 1: " << (levels.str() == "0: 0\n1: 1\n2: 2\n") << endl;
+    BinarySearchTree<std::string> quotes;
+    quotes.insert("say \"hi\"");
+    std::ostringstream json;
+    quotes.export_tree(json, TreeFormat::Json);
+    cout << json.str();
+    cout << "JSON string escaped: should be 1: "
+         << (json.str() == "{\"value\": \"say \\\"hi\\\"\", \"left\": null, \"right\": null}\n") << endl;
 }
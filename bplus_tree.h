@@ -0,0 +1,746 @@
+/*****************************************
+** File:    bplus_tree.h
+** Project: CSCE 221 Lab 4 Spring 2022
+** Author:  Naimur Rahman
+** Date:    03/21/2022
+** Section: 511
+** E-mail:  naimurrah01@tamu.edu
+** Description: Implementation for BPlusTree class, a multiway tree with cache line sized nodes
+**/
+#ifndef BPLUS_TREE_H
+#define BPLUS_TREE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "node_pool.h"
+#include "simd_search.h"
+#include "tree_print.h"
+using std::cout, std::endl;
+
+// Same set of operations as AVLTree, but each node holds as many values as fit
+// in NodeBytes (a few cache lines), so a search touches about log_B(n) nodes
+// instead of log2(n). Values live only in the leaves, which are chained left to
+// right so iterating and range scans never climb back up the tree. Inner nodes
+// hold copies of values as separators: every value under children[i] is less
+// than keys[i], and every value under children[i + 1] is not.
+// Comparable has to be default constructible and assignable, as the key arrays
+// of a node are built along with it.
+template <typename Comparable, std::size_t NodeBytes = 256, template <typename> class NodeAllocator = NodePool>
+class BPlusTree {
+private:
+    static constexpr std::size_t HEADER_BYTES = 16; // count, leaf flag and next leaf, rounded up
+
+    // key slots per node, at least 5. Each node has one slot more than it keeps between
+    // operations, so an insert can go in first and the node split after.
+    static constexpr std::size_t LEAF_SLOTS = std::max<std::size_t>(5, (NodeBytes - HEADER_BYTES) / sizeof(Comparable));
+    static constexpr std::size_t INNER_SLOTS = std::max<std::size_t>(5, (NodeBytes - HEADER_BYTES) / (sizeof(Comparable) + sizeof(void*)));
+    static constexpr unsigned LEAF_KEYS = LEAF_SLOTS - 1;   // most values in a leaf
+    static constexpr unsigned INNER_KEYS = INNER_SLOTS - 1; // most separators in an inner node
+    static constexpr unsigned LEAF_MIN = LEAF_KEYS / 2;     // fewest values in a leaf other than the root
+    static constexpr unsigned INNER_MIN = INNER_KEYS / 2;   // fewest separators in an inner node other than the root
+
+    // fields every node starts with
+    struct Node {
+        unsigned count = 0; // values in a leaf, separators in an inner node
+        bool leaf;
+        explicit Node(bool leaf) : leaf(leaf) {}
+    };
+
+    struct alignas(64) Leaf : Node {
+        Leaf* next = nullptr; // leaf to the right, nullptr for the last one
+        Comparable keys[LEAF_SLOTS];
+        Leaf() : Node(true) {}
+    };
+
+    struct alignas(64) Inner : Node {
+        Node* children[INNER_SLOTS + 1];
+        Comparable keys[INNER_SLOTS];
+        Inner() : Node(false) {}
+    };
+
+    Node* root = nullptr; // pointer to root of tree
+    std::size_t count = 0; // number of values in the tree
+    NodeAllocator<Leaf> leaves; // storage for the leaves
+    NodeAllocator<Inner> inners; // storage for the inner nodes
+
+    //-------------------------------------------------------
+    // Name: lowerIndex(const Comparable* keys, unsigned n, const Comparable& x)
+    // PreCondition:  n keys in order and Comparable x given
+    // PostCondition: returns the index of the first key not less than x, n if there is none,
+    //                with vector compares for arithmetic keys (see simd_search.h)
+    //---------------------------------------------------------
+    static unsigned lowerIndex(const Comparable* keys, unsigned n, const Comparable& x) {
+        return key_lower_bound(keys, n, x);
+    }
+
+    //-------------------------------------------------------
+    // Name: upperIndex(const Comparable* keys, unsigned n, const Comparable& x)
+    // PreCondition:  n keys in order and Comparable x given
+    // PostCondition: returns the index of the first key greater than x, which is the child of an inner node x belongs under
+    //---------------------------------------------------------
+    static unsigned upperIndex(const Comparable* keys, unsigned n, const Comparable& x) {
+        return key_upper_bound(keys, n, x);
+    }
+
+    //-------------------------------------------------------
+    // Name: findLeaf(const Comparable& x)
+    // PreCondition:  tree is not empty
+    // PostCondition: returns the leaf x is in, or would be inserted into
+    //---------------------------------------------------------
+    const Leaf* findLeaf(const Comparable& x) const {
+        const Node* n = this->root;
+        while (!n->leaf) {
+            const Inner* in = static_cast<const Inner*>(n);
+            n = in->children[upperIndex(in->keys, in->count, x)];
+        }
+        return static_cast<const Leaf*>(n);
+    }
+
+    // node storage
+
+    //-------------------------------------------------------
+    // Name: newLeaf() / newInner()
+    // PreCondition:  none
+    // PostCondition: returns a new empty node taken from its allocator
+    //---------------------------------------------------------
+    Leaf* newLeaf() {
+        Leaf* p = this->leaves.allocate();
+        try {
+            return new (p) Leaf();
+        }
+        catch (...) { // give the storage back if building the keys throws
+            this->leaves.deallocate(p);
+            throw;
+        }
+    }
+
+    Inner* newInner() {
+        Inner* p = this->inners.allocate();
+        try {
+            return new (p) Inner();
+        }
+        catch (...) {
+            this->inners.deallocate(p);
+            throw;
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: destroyNode(Node* n)
+    // PreCondition:  node n unlinked from the tree
+    // PostCondition: destroys n alone and returns its storage to the allocator
+    //---------------------------------------------------------
+    void destroyNode(Node* n) {
+        if (n->leaf) {
+            Leaf* l = static_cast<Leaf*>(n);
+            l->~Leaf();
+            this->leaves.deallocate(l);
+        }
+        else {
+            Inner* in = static_cast<Inner*>(n);
+            in->~Inner();
+            this->inners.deallocate(in);
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: destroyNodes(Node* n)
+    // PreCondition:  node n given
+    // PostCondition: destroys n and everything under it, freeing nodes one at a time unless the allocators release all
+    //---------------------------------------------------------
+    void destroyNodes(Node* n) {
+        if (!n->leaf) {
+            Inner* in = static_cast<Inner*>(n);
+            for (unsigned i = 0; i <= in->count; i++) {
+                destroyNodes(in->children[i]);
+            }
+        }
+        if (NodeAllocator<Leaf>::RELEASES_ALL) {
+            if (n->leaf) {
+                static_cast<Leaf*>(n)->~Leaf();
+            }
+            else {
+                static_cast<Inner*>(n)->~Inner();
+            }
+        }
+        else {
+            destroyNode(n);
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: copyNodes(const Node* n, Leaf*& last)
+    // PreCondition:  node n of another tree given, last is the leaf copied just before n's first leaf or nullptr
+    // PostCondition: returns a copy of n and everything under it, chaining the copied leaves on from last
+    //---------------------------------------------------------
+    Node* copyNodes(const Node* n, Leaf*& last) {
+        if (n->leaf) {
+            const Leaf* from = static_cast<const Leaf*>(n);
+            Leaf* l = newLeaf();
+            std::copy(from->keys, from->keys + from->count, l->keys);
+            l->count = from->count;
+            if (last != nullptr) {
+                last->next = l;
+            }
+            last = l;
+            return l;
+        }
+        const Inner* from = static_cast<const Inner*>(n);
+        Inner* in = newInner();
+        std::copy(from->keys, from->keys + from->count, in->keys);
+        for (unsigned i = 0; i <= from->count; i++) {
+            in->children[i] = copyNodes(from->children[i], last);
+        }
+        in->count = from->count;
+        return in;
+    }
+
+    // insert() helpers
+
+    //-------------------------------------------------------
+    // Name: insertInto(Node* n, const Comparable& x, Comparable& upKey, Node*& upNode, Leaf*& at, unsigned& atIndex)
+    // PreCondition:  node n given, x belongs under n
+    // PostCondition: puts x under n if it isn't there yet, returning whether it did. at and atIndex are set to where x is.
+    //                If n had to split, upNode is set to the new node to its right, with upKey separating the two.
+    //---------------------------------------------------------
+    bool insertInto(Node* n, const Comparable& x, Comparable& upKey, Node*& upNode, Leaf*& at, unsigned& atIndex) {
+        if (n->leaf) {
+            Leaf* l = static_cast<Leaf*>(n);
+            unsigned i = lowerIndex(l->keys, l->count, x);
+            at = l;
+            atIndex = i;
+            if (i < l->count && !(x < l->keys[i])) { // already in tree
+                return false;
+            }
+            std::move_backward(l->keys + i, l->keys + l->count, l->keys + l->count + 1);
+            l->keys[i] = x;
+            l->count++;
+            if (l->count > LEAF_KEYS) { // full, move the upper half to a new leaf
+                Leaf* right = newLeaf();
+                unsigned mid = l->count / 2;
+                std::move(l->keys + mid, l->keys + l->count, right->keys);
+                right->count = l->count - mid;
+                l->count = mid;
+                right->next = l->next;
+                l->next = right;
+                upKey = right->keys[0];
+                upNode = right;
+                if (i >= mid) {
+                    at = right;
+                    atIndex = i - mid;
+                }
+            }
+            return true;
+        }
+
+        Inner* in = static_cast<Inner*>(n);
+        unsigned c = upperIndex(in->keys, in->count, x);
+        Comparable childKey;
+        Node* childNode = nullptr;
+        bool inserted = insertInto(in->children[c], x, childKey, childNode, at, atIndex);
+        if (childNode != nullptr) { // child split, link the new node in to its right
+            std::move_backward(in->keys + c, in->keys + in->count, in->keys + in->count + 1);
+            std::move_backward(in->children + c + 1, in->children + in->count + 1, in->children + in->count + 2);
+            in->keys[c] = std::move(childKey);
+            in->children[c + 1] = childNode;
+            in->count++;
+            if (in->count > INNER_KEYS) { // full, the middle separator moves up and the upper half to a new node
+                Inner* right = newInner();
+                unsigned mid = in->count / 2;
+                upKey = std::move(in->keys[mid]);
+                std::move(in->keys + mid + 1, in->keys + in->count, right->keys);
+                std::copy(in->children + mid + 1, in->children + in->count + 1, right->children);
+                right->count = in->count - mid - 1;
+                in->count = mid;
+                upNode = right;
+            }
+        }
+        return inserted;
+    }
+
+    // remove() helpers
+
+    //-------------------------------------------------------
+    // Name: removeFrom(Node* n, const Comparable& x)
+    // PreCondition:  node n given, x belongs under n
+    // PostCondition: takes x out from under n and returns true, or returns false if it was not there.
+    //                Every node under n is left with at least its minimum, n itself may be one short.
+    //---------------------------------------------------------
+    bool removeFrom(Node* n, const Comparable& x) {
+        if (n->leaf) {
+            Leaf* l = static_cast<Leaf*>(n);
+            unsigned i = lowerIndex(l->keys, l->count, x);
+            if (i == l->count || x < l->keys[i]) { // not in tree
+                return false;
+            }
+            std::move(l->keys + i + 1, l->keys + l->count, l->keys + i);
+            l->count--;
+            return true;
+        }
+
+        Inner* in = static_cast<Inner*>(n);
+        unsigned c = upperIndex(in->keys, in->count, x);
+        if (!removeFrom(in->children[c], x)) {
+            return false;
+        }
+        Node* child = in->children[c];
+        if (child->count < (child->leaf ? LEAF_MIN : INNER_MIN)) {
+            refill(in, c);
+        }
+        return true;
+    }
+
+    //-------------------------------------------------------
+    // Name: eraseChild(Inner* p, unsigned k)
+    // PreCondition:  inner node p with separator k, whose right child has been merged away
+    // PostCondition: takes separator k and child k + 1 out of p
+    //---------------------------------------------------------
+    static void eraseChild(Inner* p, unsigned k) {
+        std::move(p->keys + k + 1, p->keys + p->count, p->keys + k);
+        std::move(p->children + k + 2, p->children + p->count + 1, p->children + k + 1);
+        p->count--;
+    }
+
+    //-------------------------------------------------------
+    // Name: refill(Inner* p, unsigned c)
+    // PreCondition:  child c of p is one below its minimum
+    // PostCondition: moves a value over from a sibling with some to spare, or else merges child c with a sibling
+    //---------------------------------------------------------
+    void refill(Inner* p, unsigned c) {
+        Node* left = (c > 0) ? p->children[c - 1] : nullptr;
+        Node* right = (c < p->count) ? p->children[c + 1] : nullptr;
+
+        if (p->children[c]->leaf) {
+            Leaf* child = static_cast<Leaf*>(p->children[c]);
+            Leaf* l = static_cast<Leaf*>(left);
+            Leaf* r = static_cast<Leaf*>(right);
+            if (l != nullptr && l->count > LEAF_MIN) { // borrow the largest value on the left
+                std::move_backward(child->keys, child->keys + child->count, child->keys + child->count + 1);
+                child->keys[0] = std::move(l->keys[--l->count]);
+                child->count++;
+                p->keys[c - 1] = child->keys[0];
+            }
+            else if (r != nullptr && r->count > LEAF_MIN) { // borrow the smallest value on the right
+                child->keys[child->count++] = std::move(r->keys[0]);
+                std::move(r->keys + 1, r->keys + r->count, r->keys);
+                r->count--;
+                p->keys[c] = r->keys[0];
+            }
+            else { // merge with a sibling, the right one of the pair goes
+                Leaf* a = (l != nullptr) ? l : child;
+                Leaf* b = (l != nullptr) ? child : r;
+                std::move(b->keys, b->keys + b->count, a->keys + a->count);
+                a->count += b->count;
+                a->next = b->next;
+                eraseChild(p, (l != nullptr) ? c - 1 : c);
+                destroyNode(b);
+            }
+            return;
+        }
+
+        Inner* child = static_cast<Inner*>(p->children[c]);
+        Inner* l = static_cast<Inner*>(left);
+        Inner* r = static_cast<Inner*>(right);
+        if (l != nullptr && l->count > INNER_MIN) { // rotate right through the separator
+            std::move_backward(child->keys, child->keys + child->count, child->keys + child->count + 1);
+            std::move_backward(child->children, child->children + child->count + 1, child->children + child->count + 2);
+            child->keys[0] = std::move(p->keys[c - 1]);
+            child->children[0] = l->children[l->count];
+            p->keys[c - 1] = std::move(l->keys[l->count - 1]);
+            l->count--;
+            child->count++;
+        }
+        else if (r != nullptr && r->count > INNER_MIN) { // rotate left through the separator
+            child->keys[child->count] = std::move(p->keys[c]);
+            child->children[child->count + 1] = r->children[0];
+            child->count++;
+            p->keys[c] = std::move(r->keys[0]);
+            std::move(r->keys + 1, r->keys + r->count, r->keys);
+            std::move(r->children + 1, r->children + r->count + 1, r->children);
+            r->count--;
+        }
+        else { // merge with a sibling, pulling the separator between them down
+            Inner* a = (l != nullptr) ? l : child;
+            Inner* b = (l != nullptr) ? child : r;
+            unsigned k = (l != nullptr) ? c - 1 : c;
+            a->keys[a->count] = std::move(p->keys[k]);
+            std::move(b->keys, b->keys + b->count, a->keys + a->count + 1);
+            std::copy(b->children, b->children + b->count + 1, a->children + a->count + 1);
+            a->count += b->count + 1;
+            eraseChild(p, k);
+            destroyNode(b);
+        }
+    }
+
+    // print_tree() helper
+
+    //-------------------------------------------------------
+    // Name: printTreeLine(const Node* n, int space, TreeWriter& out)
+    // PreCondition:  node n given with value for space, and the TreeWriter out collecting the text
+    // PostCondition: recursively prints tree rotated to out 90 degrees from node n, one line per leaf and per separator
+    //---------------------------------------------------------
+    static void printTreeLine(const Node* n, int space, TreeWriter& out) {
+        if (n->leaf) {
+            const Leaf* l = static_cast<const Leaf*>(n);
+            out.indent(2 * space).put('[');
+            for (unsigned i = 0; i < l->count; i++) {
+                if (i > 0) {
+                    out.put(' ');
+                }
+                out.value(l->keys[i]);
+            }
+            out.put(']').endLine();
+            return;
+        }
+        const Inner* in = static_cast<const Inner*>(n);
+        for (unsigned i = in->count + 1; i-- > 0;) { // right to left
+            printTreeLine(in->children[i], space + 1, out);
+            if (i > 0) {
+                out.indent(2 * space).value(in->keys[i - 1]).endLine();
+            }
+        }
+    }
+
+public:
+    //-------------------------------------------------------
+    // Name: const_iterator
+    // Description: forward in-order iterator over the values of the tree, following the leaf chain
+    //---------------------------------------------------------
+    class const_iterator {
+    private:
+        const Leaf* leaf; // current leaf, nullptr once past the end
+        unsigned index;   // position in the leaf
+
+        const_iterator(const Leaf* leaf, unsigned index) : leaf(leaf), index(index) {
+            if (this->leaf != nullptr && this->index == this->leaf->count) { // past this leaf, start of the next
+                this->leaf = this->leaf->next;
+                this->index = 0;
+            }
+        }
+        friend class BPlusTree;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Comparable;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Comparable*;
+        using reference = const Comparable&;
+
+        const_iterator() : leaf(nullptr), index(0) {}
+
+        reference operator*() const { return this->leaf->keys[this->index]; }
+        pointer operator->() const { return &this->leaf->keys[this->index]; }
+
+        const_iterator& operator++() {
+            if (++this->index == this->leaf->count) {
+                this->leaf = this->leaf->next;
+                this->index = 0;
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++(*this);
+            return old;
+        }
+
+        bool operator==(const const_iterator& rhs) const { return this->leaf == rhs.leaf && this->index == rhs.index; }
+        bool operator!=(const const_iterator& rhs) const { return !(*this == rhs); }
+    };
+
+    // values are kept in order by the tree, so they can only be read through an iterator
+    using iterator = const_iterator;
+
+    // constructors
+
+    //-------------------------------------------------------
+    // Name: BPlusTree()
+    // PreCondition: none
+    // PostCondition: creates new empty BPlusTree object
+    //---------------------------------------------------------
+    BPlusTree() = default;
+
+    //-------------------------------------------------------
+    // Name: BPlusTree(const BPlusTree& other)
+    // PreCondition: BPlusTree other passed by reference
+    // PostCondition: creates new object BPlusTree that is a copy of other, node for node
+    //---------------------------------------------------------
+    BPlusTree(const BPlusTree& other) {
+        *this = other;
+    }
+
+    //-------------------------------------------------------
+    // Name: BPlusTree(BPlusTree&& other)
+    // PreCondition: BPlusTree other passed as an rvalue
+    // PostCondition: creates new object BPlusTree that takes over the nodes of other, leaving other empty.
+    //                Never throws, so containers of trees move them instead of copying.
+    //---------------------------------------------------------
+    BPlusTree(BPlusTree&& other) noexcept : root(other.root), count(other.count) {
+        other.root = nullptr;
+        other.count = 0;
+        this->leaves.swap(other.leaves);
+        this->inners.swap(other.inners);
+    }
+
+    // destructor
+
+    //-------------------------------------------------------
+    // Name: ~BPlusTree()
+    // PreCondition: BPlusTree object has already been created
+    // PostCondition: destroys all nodes
+    //---------------------------------------------------------
+    ~BPlusTree() {
+        make_empty();
+    }
+
+    // assignment operator
+
+    //-------------------------------------------------------
+    // Name: operator=(const BPlusTree& other)
+    // PreCondition: BPlusTree other passed by reference
+    // PostCondition: return copy of other, having changed this object
+    //---------------------------------------------------------
+    BPlusTree& operator=(const BPlusTree& other) {
+        if (this != &other) { // if not same object
+            make_empty();
+            if (other.root != nullptr) {
+                Leaf* last = nullptr;
+                this->root = copyNodes(other.root, last);
+                this->count = other.count;
+            }
+        }
+        return *this;
+    }
+
+    //-------------------------------------------------------
+    // Name: operator=(BPlusTree&& other)
+    // PreCondition: BPlusTree other passed as an rvalue
+    // PostCondition: frees this tree and takes over the nodes of other, leaving other empty
+    //---------------------------------------------------------
+    BPlusTree& operator=(BPlusTree&& other) noexcept {
+        if (this != &other) { // if not same object
+            make_empty();
+            std::swap(this->root, other.root);
+            std::swap(this->count, other.count);
+            this->leaves.swap(other.leaves);
+            this->inners.swap(other.inners);
+        }
+        return *this;
+    }
+
+    //-------------------------------------------------------
+    // Name: contains(const Comparable& value)
+    // PreCondition: Comparable value passed by reference
+    // PostCondition: return true if value is in the tree, false if not
+    //---------------------------------------------------------
+    bool contains(const Comparable& value) const {
+        if (this->root == nullptr) { // empty tree
+            return false;
+        }
+        const Leaf* l = findLeaf(value);
+        unsigned i = lowerIndex(l->keys, l->count, value);
+        return i < l->count && !(value < l->keys[i]);
+    }
+
+    //-------------------------------------------------------
+    // Name: insert(const Comparable& value)
+    // PreCondition: Comparable value passed by reference
+    // PostCondition: puts value into its leaf, splitting full nodes on the way back up.
+    //                Returns an iterator to value in the tree and whether it was inserted.
+    //---------------------------------------------------------
+    std::pair<const_iterator, bool> insert(const Comparable& value) {
+        if (this->root == nullptr) {
+            this->root = newLeaf();
+        }
+        Comparable upKey;
+        Node* upNode = nullptr;
+        Leaf* at;
+        unsigned atIndex;
+        bool inserted = insertInto(this->root, value, upKey, upNode, at, atIndex);
+        if (upNode != nullptr) { // root split, the tree grows a level
+            Inner* top = newInner();
+            top->children[0] = this->root;
+            top->children[1] = upNode;
+            top->keys[0] = std::move(upKey);
+            top->count = 1;
+            this->root = top;
+        }
+        this->count += inserted;
+        return {const_iterator(at, atIndex), inserted};
+    }
+
+    //-------------------------------------------------------
+    // Name: remove(const Comparable& value)
+    // PreCondition: Comparable value passed by reference
+    // PostCondition: takes value out of the tree if it is there, refilling or merging nodes that fall below half full
+    //---------------------------------------------------------
+    void remove(const Comparable& value) {
+        if (this->root == nullptr || !removeFrom(this->root, value)) {
+            return;
+        }
+        this->count--;
+        if (this->root->count == 0) { // root ran out, the tree shrinks a level
+            Node* old = this->root;
+            this->root = old->leaf ? nullptr : static_cast<Inner*>(old)->children[0];
+            destroyNode(old);
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: find_min()
+    // PreCondition: root is not a nullptr
+    // PostCondition: returns the minimum value in the tree
+    //---------------------------------------------------------
+    const Comparable& find_min() const {
+        if (this->root == nullptr) {
+            throw std::invalid_argument("BPlusTree is empty");
+        }
+        const Node* n = this->root;
+        while (!n->leaf) { // get to leftmost leaf
+            n = static_cast<const Inner*>(n)->children[0];
+        }
+        return static_cast<const Leaf*>(n)->keys[0];
+    }
+
+    //-------------------------------------------------------
+    // Name: find_max()
+    // PreCondition: root is not a nullptr
+    // PostCondition: returns the maximum value in the tree
+    //---------------------------------------------------------
+    const Comparable& find_max() const {
+        if (this->root == nullptr) {
+            throw std::invalid_argument("BPlusTree is empty");
+        }
+        const Node* n = this->root;
+        while (!n->leaf) { // get to rightmost leaf
+            const Inner* in = static_cast<const Inner*>(n);
+            n = in->children[in->count];
+        }
+        const Leaf* l = static_cast<const Leaf*>(n);
+        return l->keys[l->count - 1];
+    }
+
+    //-------------------------------------------------------
+    // Name: begin()
+    // PreCondition: none
+    // PostCondition: returns an iterator to the minimum value, or end() if the tree is empty
+    //---------------------------------------------------------
+    const_iterator begin() const {
+        const Node* n = this->root;
+        if (n == nullptr) {
+            return end();
+        }
+        while (!n->leaf) { // get to leftmost leaf
+            n = static_cast<const Inner*>(n)->children[0];
+        }
+        return const_iterator(static_cast<const Leaf*>(n), 0);
+    }
+
+    //-------------------------------------------------------
+    // Name: end()
+    // PreCondition: none
+    // PostCondition: returns the iterator one past the maximum value
+    //---------------------------------------------------------
+    const_iterator end() const { return const_iterator(); }
+
+    //-------------------------------------------------------
+    // Name: lower_bound(const Comparable& value)
+    // PreCondition: Comparable value passed by reference
+    // PostCondition: returns an iterator to the first value not less than value, or end()
+    //---------------------------------------------------------
+    const_iterator lower_bound(const Comparable& value) const {
+        if (this->root == nullptr) {
+            return end();
+        }
+        const Leaf* l = findLeaf(value);
+        return const_iterator(l, lowerIndex(l->keys, l->count, value));
+    }
+
+    //-------------------------------------------------------
+    // Name: upper_bound(const Comparable& value)
+    // PreCondition: Comparable value passed by reference
+    // PostCondition: returns an iterator to the first value greater than value, or end()
+    //---------------------------------------------------------
+    const_iterator upper_bound(const Comparable& value) const {
+        if (this->root == nullptr) {
+            return end();
+        }
+        const Leaf* l = findLeaf(value);
+        return const_iterator(l, upperIndex(l->keys, l->count, value));
+    }
+
+    //-------------------------------------------------------
+    // Name: for_each_in_range(const Comparable& lo, const Comparable& hi, Function fn)
+    // PreCondition: range lo to hi and a function taking a value given
+    // PostCondition: calls fn on every value v with lo <= v < hi in order, walking the leaf chain
+    //---------------------------------------------------------
+    template <typename Function>
+    void for_each_in_range(const Comparable& lo, const Comparable& hi, Function fn) const {
+        for (const_iterator it = lower_bound(lo); it != end() && *it < hi; ++it) {
+            fn(*it);
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: print_tree(std::ostream& os=std::cout)
+    // PreCondition: ostream os defaults to cout if none given
+    // PostCondition: prints 90 degree rotated tree to os, each leaf in brackets on its own line
+    //---------------------------------------------------------
+    void print_tree(std::ostream& os=std::cout) const {
+        if (!is_empty()) {
+            TreeWriter out(os);
+            printTreeLine(this->root, 0, out);
+        }
+        else { // empty tree
+            os << "<empty>\n";
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: is_empty()
+    // PreCondition: none
+    // PostCondition: returns true if tree is empty, false if it isnt
+    //---------------------------------------------------------
+    bool is_empty() const { return (this->root == nullptr); }
+
+    //-------------------------------------------------------
+    // Name: size()
+    // PreCondition: none
+    // PostCondition: returns the number of values in the tree
+    //---------------------------------------------------------
+    std::size_t size() const { return this->count; }
+
+    //-------------------------------------------------------
+    // Name: leaf_capacity() / inner_capacity()
+    // PreCondition: none
+    // PostCondition: returns the most values a leaf holds, and the most separators an inner node holds
+    //---------------------------------------------------------
+    static constexpr std::size_t leaf_capacity() { return LEAF_KEYS; }
+    static constexpr std::size_t inner_capacity() { return INNER_KEYS; }
+
+    //-------------------------------------------------------
+    // Name: make_empty()
+    // PreCondition: none
+    // PostCondition: destroys all nodes, making the tree empty
+    //---------------------------------------------------------
+    void make_empty() {
+        if (this->root != nullptr) {
+            if (!NodeAllocator<Leaf>::RELEASES_ALL || !std::is_trivially_destructible<Comparable>::value) {
+                destroyNodes(this->root);
+            }
+            this->root = nullptr;
+        }
+        this->count = 0;
+        this->leaves.release();
+        this->inners.release();
+    }
+};
+
+#endif
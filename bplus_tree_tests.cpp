@@ -0,0 +1,137 @@
+/*****************************************
+** File:    bplus_tree_tests.cpp
+** Project: CSCE 221 Lab 4 Spring 2022
+** Author:  Naimur Rahman
+** Date:    03/21/2022
+** Section: 511
+** E-mail:  naimurrah01@tamu.edu
+** Description: Tests for BPlusTree Class
+**/
+#include <iostream>
+#include <type_traits>
+#include <vector>
+#include "bplus_tree.h"
+
+using std::cout, std::endl;
+
+int main() {
+    // 32 byte nodes hold 4 values each, so small trees already have several levels
+    BPlusTree<int, 32> t;
+
+    // fail min/max test:
+    try {
+        t.find_min();
+    }
+    catch (const std::invalid_argument&) {
+        cout << "Invalid min test success" << endl;
+    }
+    try {
+        t.find_max();
+    }
+    catch (const std::invalid_argument&) {
+        cout << "Invalid max test success" << endl;
+    }
+    cout << "printing empty tree: " << endl;
+    t.print_tree();
+    cout << "Empty? should be 1: " << t.is_empty() << endl;
+    cout << "Leaf capacity: should be 4: " << t.leaf_capacity() << endl;
+    cout << endl;
+
+    // inserting
+    for (int i = 1; i <= 20; i++) {
+        t.insert(i);
+    }
+    t.print_tree();
+    cout << "Size: should be 20: " << t.size() << endl;
+    cout << "Min: should be 1: " << t.find_min() << endl;
+    cout << "Max: should be 20: " << t.find_max() << endl;
+    cout << "Inserting 7 again: should be 0: " << t.insert(7).second << endl;
+    cout << "Iterator from insert: should be 7: " << *t.insert(7).first << endl;
+    cout << "Size: should be 20: " << t.size() << endl;
+    cout << endl;
+
+    // range scans follow the leaf chain
+    cout << "Values from 5 up to 12: should be 5 6 7 8 9 10 11: ";
+    t.for_each_in_range(5, 12, [](int v) { cout << v << ' '; });
+    cout << endl;
+    cout << "lower_bound(0): should be 1: " << *t.lower_bound(0) << endl;
+    cout << "upper_bound(20) is end: should be 1: " << (t.upper_bound(20) == t.end()) << endl;
+    cout << endl;
+
+    // removing, which refills and merges nodes
+    for (int i = 2; i <= 20; i += 2) {
+        t.remove(i);
+    }
+    t.remove(100);
+    t.print_tree();
+    cout << "Size: should be 10: " << t.size() << endl;
+    cout << "Contains 4: should be 0: " << t.contains(4) << endl;
+    cout << "Contains 19: should be 1: " << t.contains(19) << endl;
+    cout << "In order: should be 1 3 5 7 9 11 13 15 17 19: ";
+    for (int v : t) {
+        cout << v << ' ';
+    }
+    cout << endl;
+    cout << endl;
+
+    // copying, moving and emptying
+    BPlusTree<int, 32> cop(t);
+    t.make_empty();
+    cout << "Empty after make_empty: should be 1: " << t.is_empty() << endl;
+    cout << "Copy size: should be 10: " << cop.size() << endl;
+    BPlusTree<int, 32> moved(std::move(cop));
+    cout << "Moved from is empty: should be 1: " << cop.is_empty() << endl;
+    cout << "Moved max: should be 19: " << moved.find_max() << endl;
+    static_assert(std::is_nothrow_move_constructible<BPlusTree<int>>::value, "containers of trees move them");
+    static_assert(std::is_nothrow_move_assignable<BPlusTree<int>>::value, "containers of trees move them");
+    std::vector<BPlusTree<int, 32>> forest(1);
+    forest[0].insert(7);
+    const int* kept = &forest[0].find_min();
+    for (int i = 0; i < 100; i++) { // reallocates a few times
+        forest.emplace_back();
+    }
+    cout << "Tree moved, not copied, when a vector grows: should be 1: " << (&forest[0].find_min() == kept) << endl;
+    t = moved;
+    cout << "Assigned min: should be 1: " << t.find_min() << endl;
+    cout << endl;
+
+    // bigger tree with the default cache line sized nodes
+    BPlusTree<int> big;
+    for (int i = 0; i < 100000; i++) {
+        big.insert((i * 7919) % 100000);
+    }
+    for (int i = 0; i < 100000; i += 2) {
+        big.remove(i);
+    }
+    int wrong = 0;
+    for (int i = 0; i < 100000; i++) {
+        if (big.contains(i) != (i % 2 == 1)) {
+            wrong++;
+        }
+    }
+    int expected = 1;
+    for (int v : big) {
+        wrong += (v != expected);
+        expected += 2;
+    }
+    cout << "Wrong answers after 100000 inserts and 50000 removes: should be 0: " << wrong << endl;
+    cout << "Size: should be 50000: " << big.size() << endl;
+    cout << "Min: should be 1: " << big.find_min() << endl;
+    cout << "Max: should be 99999: " << big.find_max() << endl;
+    for (int i = 1; i < 100000; i += 2) {
+        big.remove(i);
+    }
+    cout << "Empty after removing the rest: should be 1: " << big.is_empty() << endl;
+    cout << endl;
+
+    // char tree
+    BPlusTree<char> ct;
+    ct.insert('c');
+    ct.insert('a');
+    ct.insert('z');
+    ct.insert('b');
+    ct.print_tree();
+    cout << "Min val: should be a: " << ct.find_min() << endl;
+    cout << "Max val: should be z: " << ct.find_max() << endl;
+    return 0;
+}
@@ -5,15 +5,224 @@
 ** Date:    03/21/2022
 ** Section: 511
 ** E-mail:  naimurrah01@tamu.edu
-** Description: Interactive way to build a tree
+** Description: Interactive way to build a tree, or a streaming one to replay a log of operations
+**              usage: ./a.out                     asks for values and prints the tree after each one
+**                     ./a.out avl|bst [file]      streams values from file, or stdin if none or -, and prints
+**                                                 only the speed and the final tree's statistics
 **/
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <vector>
 #include "binary_search_tree.h"
 #include "avl_tree.h"
 
 using std::cout, std::endl, std::cin;
 
-int main() {
+const std::size_t READ_BUFFER = 1 << 20; // bytes read from the input at a time
+const std::size_t BATCH_OPS = 1 << 16;   // most values applied to the tree in one batch
+const std::size_t BATCH_MIN_RUN = 64;    // shorter runs go into an AVLTree one value at a time
+
+// Reads the values of the protocol, the same whitespace separated integers
+// the interactive mode takes, out of a large buffer filled with fread, and
+// parses them by hand instead of with formatted extraction, which looks up
+// the locale and checks the stream state for every value.
+class ValueReader {
+private:
+    std::FILE* in;             // file read from
+    std::vector<char> buffer;  // bytes read and not parsed yet are pos up to end
+    std::size_t pos = 0;
+    std::size_t end = 0;
+
+    //-------------------------------------------------------
+    // Name: peek()
+    // PreCondition:  none
+    // PostCondition: returns the next byte without taking it, refilling the buffer if needed, EOF at the end
+    //---------------------------------------------------------
+    int peek() {
+        if (this->pos == this->end) {
+            this->pos = 0;
+            this->end = std::fread(this->buffer.data(), 1, this->buffer.size(), this->in);
+            if (this->end == 0) {
+                return EOF;
+            }
+        }
+        return static_cast<unsigned char>(this->buffer[this->pos]);
+    }
+
+public:
+    //-------------------------------------------------------
+    // Name: ValueReader(std::FILE* in)
+    // PreCondition:  file in open for reading
+    // PostCondition: creates a reader of the values in in
+    //---------------------------------------------------------
+    explicit ValueReader(std::FILE* in) : in(in), buffer(READ_BUFFER) {}
+
+    //-------------------------------------------------------
+    // Name: next(int& value)
+    // PreCondition:  none
+    // PostCondition: reads the next integer, with an optional + or - sign, into value and returns true.
+    //                Returns false at the end of the input, or at anything that is not an int.
+    //---------------------------------------------------------
+    bool next(int& value) {
+        int c = peek();
+        while (c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f') {
+            this->pos++;
+            c = peek();
+        }
+        bool negative = (c == '-');
+        if (c == '-' || c == '+') {
+            this->pos++;
+            c = peek();
+        }
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        long long magnitude = 0;
+        while (c >= '0' && c <= '9') {
+            magnitude = magnitude * 10 + (c - '0');
+            if (magnitude > static_cast<long long>(INT_MAX) + 1) { // does not fit, like cin >> value failing
+                return false;
+            }
+            this->pos++;
+            c = peek();
+        }
+        if (!negative && magnitude > INT_MAX) {
+            return false;
+        }
+        value = static_cast<int>(negative ? -magnitude : magnitude);
+        return true;
+    }
+};
+
+//-------------------------------------------------------
+// Name: applyRun(AVLTree<int>& tree, const std::vector<int>& run, bool inserting)
+// PreCondition:  tree, values of a run of inserts or of removes, and which one it is
+// PostCondition: applies the run as one batch if it has at least BATCH_MIN_RUN values, one at a time if not.
+//                The order within a run of inserts or of removes does not matter.
+//---------------------------------------------------------
+void applyRun(AVLTree<int>& tree, const std::vector<int>& run, bool inserting) {
+    if (run.size() < BATCH_MIN_RUN) { // sorting and splicing in a batch costs more than it saves
+        for (int value : run) {
+            if (inserting) {
+                tree.insert(value);
+            }
+            else {
+                tree.remove(value);
+            }
+        }
+    }
+    else if (inserting) {
+        tree.insert_batch(run.begin(), run.end());
+    }
+    else {
+        tree.remove_batch(run.begin(), run.end());
+    }
+}
+
+//-------------------------------------------------------
+// Name: applyRun(BinarySearchTree<int>& tree, const std::vector<int>& run, bool inserting)
+// PreCondition:  tree, values of a run of inserts or of removes, and which one it is
+// PostCondition: applies the run one value at a time, BinarySearchTree having no batch operations
+//---------------------------------------------------------
+void applyRun(BinarySearchTree<int>& tree, const std::vector<int>& run, bool inserting) {
+    for (int value : run) {
+        if (inserting) {
+            tree.insert(value);
+        }
+        else {
+            tree.remove(value);
+        }
+    }
+}
+
+//-------------------------------------------------------
+// Name: streamInto(Tree& tree, ValueReader& reader)
+// PreCondition:  tree to build and reader of the values
+// PostCondition: reads values until the end of the input, 0 or a non-integer, inserting positive values
+//                and removing the absolute value of negative ones. Consecutive values with the same sign are
+//                applied together, up to BATCH_OPS at a time. Prints the speed and the final tree's statistics.
+//---------------------------------------------------------
+template <typename Tree>
+void streamInto(Tree& tree, ValueReader& reader) {
+    std::vector<int> run;
+    run.reserve(BATCH_OPS);
+    bool inserting = true;
+    std::size_t inserts = 0;
+    std::size_t removes = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    int value = 0;
+    while (reader.next(value) && value != 0) {
+        bool insert = value > 0;
+        if (insert != inserting || run.size() == BATCH_OPS) { // the run ends
+            applyRun(tree, run, inserting);
+            run.clear();
+            inserting = insert;
+        }
+        if (insert) {
+            run.push_back(value);
+            inserts++;
+        }
+        else {
+            run.push_back(value == INT_MIN ? INT_MIN : -value); // -INT_MIN does not fit, and is in no tree
+            removes++;
+        }
+    }
+    applyRun(tree, run, inserting);
+    std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+
+    std::size_t ops = inserts + removes;
+    cout << "operations: " << ops << " (" << inserts << " inserts, " << removes << " removes)" << '\n';
+    cout << "seconds: " << seconds.count() << '\n';
+    cout << "ops/sec: " << (seconds.count() > 0 ? static_cast<double>(ops) / seconds.count() : 0.0) << '\n';
+    cout << "size: " << tree.size() << '\n';
+    if (!tree.is_empty()) {
+        cout << "min: " << tree.find_min() << '\n';
+        cout << "max: " << tree.find_max() << '\n';
+    }
+    cout.flush();
+}
+
+//-------------------------------------------------------
+// Name: streamOperations(const char* kind, const char* path)
+// PreCondition:  avl or bst, and the file to read, nullptr or - for stdin
+// PostCondition: builds the tree from the values in the file without printing it, returns the exit status
+//---------------------------------------------------------
+int streamOperations(const char* kind, const char* path) {
+    bool isAVL = std::strcmp(kind, "avl") == 0;
+    if (!isAVL && std::strcmp(kind, "bst") != 0) {
+        std::cerr << kind << " is invalid, expected avl or bst." << endl;
+        return 1;
+    }
+    bool fromStdin = (path == nullptr || std::strcmp(path, "-") == 0);
+    std::FILE* in = fromStdin ? stdin : std::fopen(path, "rb");
+    if (in == nullptr) {
+        std::cerr << "could not open " << path << endl;
+        return 1;
+    }
+    ValueReader reader(in);
+    if (isAVL) {
+        AVLTree<int> avl;
+        streamInto(avl, reader);
+    }
+    else {
+        BinarySearchTree<int> bst;
+        bst.set_rebalancing(true); // logs are often in order, which would make the tree a list
+        streamInto(bst, reader);
+    }
+    if (!fromStdin) {
+        std::fclose(in);
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        return streamOperations(argv[1], (argc > 2) ? argv[2] : nullptr);
+    }
+
     // build a tree of ints
     BinarySearchTree<int> bst;
     AVLTree<int> avl;
@@ -0,0 +1,498 @@
+/*****************************************
+** File:    compact_avl_tree.h
+** Project: CSCE 221 Lab 4 Spring 2022
+** Author:  Naimur Rahman
+** Date:    03/21/2022
+** Section: 511
+** E-mail:  naimurrah01@tamu.edu
+** Description: Implementation for CompactAVLTree class, an AVL tree kept in one vector
+**/
+#ifndef COMPACT_AVL_TREE_H
+#define COMPACT_AVL_TREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "tree_print.h"
+using std::cout, std::endl;
+
+// Same set of operations as AVLTree, but the nodes live next to each other in a
+// vector and point at their children with 32-bit indices. Instead of an int
+// height each node keeps its balance factor in the top bit of its two links, so
+// an AVLTree<int> node of 48 bytes shrinks to 12.
+template <typename Comparable>
+class CompactAVLTree {
+private:
+    static const std::uint32_t NIL = 0x7FFFFFFF;        // index meaning no node
+    static const std::uint32_t INDEX_MASK = 0x7FFFFFFF; // low 31 bits of a link are the index
+    static const std::uint32_t TALLER = 0x80000000;     // top bit of a link: that subtree is one taller
+
+    // struct for nodes of the tree
+    struct compactNode {
+        Comparable data;
+        std::uint32_t child[2]; // indices of left and right child, TALLER set on the higher side
+    };
+
+    std::vector<compactNode> nodes; // every node, in the order they were created
+    std::uint32_t root = NIL;       // index of root
+    std::uint32_t freeList = NIL;   // removed nodes waiting to be reused, chained through child[0]
+    std::size_t count = 0;          // number of values in the tree
+
+    // link helpers
+
+    std::uint32_t leftOf(std::uint32_t t) const { return this->nodes[t].child[0] & INDEX_MASK; }
+    std::uint32_t rightOf(std::uint32_t t) const { return this->nodes[t].child[1] & INDEX_MASK; }
+
+    void setLeft(std::uint32_t t, std::uint32_t c) {
+        this->nodes[t].child[0] = (this->nodes[t].child[0] & TALLER) | c;
+    }
+
+    void setRight(std::uint32_t t, std::uint32_t c) {
+        this->nodes[t].child[1] = (this->nodes[t].child[1] & TALLER) | c;
+    }
+
+    //-------------------------------------------------------
+    // Name: balanceOf(std::uint32_t t)
+    // PreCondition:  index t of a node given
+    // PostCondition: returns -1 if the left subtree of t is taller, 1 if the right one is, 0 if even
+    //---------------------------------------------------------
+    int balanceOf(std::uint32_t t) const {
+        if (this->nodes[t].child[0] & TALLER) {
+            return -1;
+        }
+        return (this->nodes[t].child[1] & TALLER) ? 1 : 0;
+    }
+
+    //-------------------------------------------------------
+    // Name: setBalance(std::uint32_t t, int b)
+    // PreCondition:  index t of a node and balance factor b of -1, 0 or 1 given
+    // PostCondition: stores b in the top bits of the links of t
+    //---------------------------------------------------------
+    void setBalance(std::uint32_t t, int b) {
+        this->nodes[t].child[0] = (this->nodes[t].child[0] & INDEX_MASK) | (b < 0 ? TALLER : 0);
+        this->nodes[t].child[1] = (this->nodes[t].child[1] & INDEX_MASK) | (b > 0 ? TALLER : 0);
+    }
+
+    //-------------------------------------------------------
+    // Name: createNode(const Comparable& x)
+    // PreCondition:  Comparable x given
+    // PostCondition: returns the index of a new leaf holding x, reusing a removed node if there is one
+    //---------------------------------------------------------
+    std::uint32_t createNode(const Comparable& x) {
+        std::uint32_t t;
+        if (this->freeList != NIL) {
+            t = this->freeList;
+            this->freeList = this->nodes[t].child[0];
+            this->nodes[t].data = x;
+        }
+        else {
+            if (this->nodes.size() >= NIL) {
+                throw std::length_error("CompactAVLTree is full");
+            }
+            t = static_cast<std::uint32_t>(this->nodes.size());
+            this->nodes.push_back(compactNode{x, {NIL, NIL}});
+        }
+        this->nodes[t].child[0] = NIL;
+        this->nodes[t].child[1] = NIL;
+        return t;
+    }
+
+    //-------------------------------------------------------
+    // Name: freeNode(std::uint32_t t)
+    // PreCondition:  index t of a node unlinked from the tree
+    // PostCondition: puts t on the free list, its data is overwritten when it is reused
+    //---------------------------------------------------------
+    void freeNode(std::uint32_t t) {
+        this->nodes[t].child[0] = this->freeList;
+        this->freeList = t;
+    }
+
+    // rotators - helpers for balancing
+
+    //-------------------------------------------------------
+    // Name: fixLeftHeavy(std::uint32_t& t)
+    // PreCondition:  index t of a node whose left subtree is two taller than its right
+    // PostCondition: rotates t back into balance, t becomes the new subtree root.
+    //                Returns true if the subtree is now one shorter than before the rotation.
+    //---------------------------------------------------------
+    bool fixLeftHeavy(std::uint32_t& t) {
+        std::uint32_t k1 = leftOf(t);
+        int b = balanceOf(k1);
+        if (b <= 0) { // single rotation with left child
+            setLeft(t, rightOf(k1));
+            setRight(k1, t);
+            if (b == 0) { // only after a remove, height stays the same
+                setBalance(t, -1);
+                setBalance(k1, 1);
+                t = k1;
+                return false;
+            }
+            setBalance(t, 0);
+            setBalance(k1, 0);
+            t = k1;
+            return true;
+        }
+
+        // double rotation, the right child of k1 becomes the root
+        std::uint32_t k2 = rightOf(k1);
+        int b2 = balanceOf(k2);
+        setRight(k1, leftOf(k2));
+        setLeft(t, rightOf(k2));
+        setLeft(k2, k1);
+        setRight(k2, t);
+        setBalance(k1, (b2 > 0) ? -1 : 0);
+        setBalance(t, (b2 < 0) ? 1 : 0);
+        setBalance(k2, 0);
+        t = k2;
+        return true;
+    }
+
+    //-------------------------------------------------------
+    // Name: fixRightHeavy(std::uint32_t& t)
+    // PreCondition:  index t of a node whose right subtree is two taller than its left
+    // PostCondition: rotates t back into balance, t becomes the new subtree root.
+    //                Returns true if the subtree is now one shorter than before the rotation.
+    //---------------------------------------------------------
+    bool fixRightHeavy(std::uint32_t& t) {
+        std::uint32_t k1 = rightOf(t);
+        int b = balanceOf(k1);
+        if (b >= 0) { // single rotation with right child
+            setRight(t, leftOf(k1));
+            setLeft(k1, t);
+            if (b == 0) { // only after a remove, height stays the same
+                setBalance(t, 1);
+                setBalance(k1, -1);
+                t = k1;
+                return false;
+            }
+            setBalance(t, 0);
+            setBalance(k1, 0);
+            t = k1;
+            return true;
+        }
+
+        // double rotation, the left child of k1 becomes the root
+        std::uint32_t k2 = leftOf(k1);
+        int b2 = balanceOf(k2);
+        setLeft(k1, rightOf(k2));
+        setRight(t, leftOf(k2));
+        setRight(k2, k1);
+        setLeft(k2, t);
+        setBalance(k1, (b2 < 0) ? 1 : 0);
+        setBalance(t, (b2 > 0) ? -1 : 0);
+        setBalance(k2, 0);
+        t = k2;
+        return true;
+    }
+
+    // insert() and remove() helpers, t is always a copy of the link so the vector may grow underneath
+
+    //-------------------------------------------------------
+    // Name: insertSub(const Comparable& x, std::uint32_t& t, bool& inserted)
+    // PreCondition:  Comparable x and index t of a subtree root given
+    // PostCondition: inserts x below t, setting inserted if it was not there yet.
+    //                Returns true if the subtree got taller.
+    //---------------------------------------------------------
+    bool insertSub(const Comparable& x, std::uint32_t& t, bool& inserted) {
+        if (t == NIL) { // create node with data x
+            t = createNode(x);
+            inserted = true;
+            return true;
+        }
+
+        if (x < this->nodes[t].data) { // shift left
+            std::uint32_t child = leftOf(t);
+            bool grew = insertSub(x, child, inserted);
+            setLeft(t, child);
+            if (!grew) {
+                return false;
+            }
+            int b = balanceOf(t);
+            if (b == 0) {
+                setBalance(t, -1);
+                return true;
+            }
+            if (b > 0) {
+                setBalance(t, 0);
+                return false;
+            }
+            fixLeftHeavy(t); // back to the height it had before the insert
+            return false;
+        }
+
+        if (this->nodes[t].data < x) { // shift right
+            std::uint32_t child = rightOf(t);
+            bool grew = insertSub(x, child, inserted);
+            setRight(t, child);
+            if (!grew) {
+                return false;
+            }
+            int b = balanceOf(t);
+            if (b == 0) {
+                setBalance(t, 1);
+                return true;
+            }
+            if (b < 0) {
+                setBalance(t, 0);
+                return false;
+            }
+            fixRightHeavy(t);
+            return false;
+        }
+
+        return false; // already in tree
+    }
+
+    //-------------------------------------------------------
+    // Name: leftShrank(std::uint32_t& t)
+    // PreCondition:  index t of a node whose left subtree just got one shorter
+    // PostCondition: updates the balance of t, rotating if needed. Returns true if t's subtree got shorter.
+    //---------------------------------------------------------
+    bool leftShrank(std::uint32_t& t) {
+        int b = balanceOf(t);
+        if (b < 0) {
+            setBalance(t, 0);
+            return true;
+        }
+        if (b == 0) {
+            setBalance(t, 1);
+            return false;
+        }
+        return fixRightHeavy(t);
+    }
+
+    //-------------------------------------------------------
+    // Name: rightShrank(std::uint32_t& t)
+    // PreCondition:  index t of a node whose right subtree just got one shorter
+    // PostCondition: updates the balance of t, rotating if needed. Returns true if t's subtree got shorter.
+    //---------------------------------------------------------
+    bool rightShrank(std::uint32_t& t) {
+        int b = balanceOf(t);
+        if (b > 0) {
+            setBalance(t, 0);
+            return true;
+        }
+        if (b == 0) {
+            setBalance(t, -1);
+            return false;
+        }
+        return fixLeftHeavy(t);
+    }
+
+    //-------------------------------------------------------
+    // Name: removeMin(std::uint32_t& t, std::uint32_t& min)
+    // PreCondition:  index t of a non empty subtree given
+    // PostCondition: unlinks the minimum node of the subtree into min. Returns true if the subtree got shorter.
+    //---------------------------------------------------------
+    bool removeMin(std::uint32_t& t, std::uint32_t& min) {
+        std::uint32_t child = leftOf(t);
+        if (child == NIL) { // t is the minimum, its right child takes its place
+            min = t;
+            t = rightOf(t);
+            return true;
+        }
+        bool shrank = removeMin(child, min);
+        setLeft(t, child);
+        return shrank && leftShrank(t);
+    }
+
+    //-------------------------------------------------------
+    // Name: removeSub(const Comparable& x, std::uint32_t& t, bool& removed)
+    // PreCondition:  Comparable x and index t of a subtree root given
+    // PostCondition: removes x from below t, setting removed if it was there.
+    //                Returns true if the subtree got shorter.
+    //---------------------------------------------------------
+    bool removeSub(const Comparable& x, std::uint32_t& t, bool& removed) {
+        if (t == NIL) {
+            return false;
+        }
+
+        if (x < this->nodes[t].data) { // shift left
+            std::uint32_t child = leftOf(t);
+            bool shrank = removeSub(x, child, removed);
+            setLeft(t, child);
+            return shrank && leftShrank(t);
+        }
+        if (this->nodes[t].data < x) { // shift right
+            std::uint32_t child = rightOf(t);
+            bool shrank = removeSub(x, child, removed);
+            setRight(t, child);
+            return shrank && rightShrank(t);
+        }
+
+        removed = true;
+        std::uint32_t old = t;
+        if (leftOf(t) == NIL || rightOf(t) == NIL) { // at most one child, which moves up
+            t = (leftOf(t) != NIL) ? leftOf(t) : rightOf(t);
+            freeNode(old);
+            return true;
+        }
+
+        // two children, the minimum of the right subtree takes t's place
+        std::uint32_t right = rightOf(t);
+        std::uint32_t min;
+        bool shrank = removeMin(right, min);
+        this->nodes[min].child[0] = this->nodes[old].child[0];
+        this->nodes[min].child[1] = (this->nodes[old].child[1] & TALLER) | right;
+        freeNode(old);
+        t = min;
+        return shrank && rightShrank(t);
+    }
+
+    // print_tree() helper
+    //-------------------------------------------------------
+    // Name: printTreeLine(std::uint32_t p, int space, TreeWriter& out)
+    // PreCondition:  index p of a node given with value for space, and the TreeWriter out collecting the text
+    // PostCondition: recursively prints tree rotated to out 90 degrees from node p
+    //---------------------------------------------------------
+    void printTreeLine(std::uint32_t p, int space, TreeWriter& out) const {
+        if (p == NIL) {
+            return;
+        }
+        space++; // amount of levels
+        printTreeLine(rightOf(p), space, out);
+        out.indent(2 * (space - 1)).value(this->nodes[p].data).endLine();
+        printTreeLine(leftOf(p), space, out);
+    }
+
+public:
+    // constructors, copying and moving copy or move the node vector as is
+
+    //-------------------------------------------------------
+    // Name: CompactAVLTree()
+    // PreCondition: none
+    // PostCondition: creates new empty CompactAVLTree object
+    //---------------------------------------------------------
+    CompactAVLTree() = default;
+
+    //-------------------------------------------------------
+    // Name: contains(const Comparable& value)
+    // PreCondition: Comparable value passed by reference
+    // PostCondition: return true if value is a node in the tree, false if not
+    //---------------------------------------------------------
+    bool contains(const Comparable& value) const {
+        std::uint32_t current = this->root;
+        std::uint32_t candidate = NIL; // deepest node seen that is not less than value
+        while (current != NIL) {
+            const compactNode& n = this->nodes[current];
+            bool goRight = n.data < value;
+            candidate = goRight ? candidate : current;
+            current = n.child[goRight] & INDEX_MASK; // indexing instead of branching on the side
+        }
+        return candidate != NIL && !(value < this->nodes[candidate].data);
+    }
+
+    //-------------------------------------------------------
+    // Name: insert(const Comparable& value)
+    // PreCondition: Comparable value passed by reference
+    // PostCondition: puts value into the tree if it is not there yet, balancing it as well
+    //---------------------------------------------------------
+    void insert(const Comparable& value) {
+        bool inserted = false;
+        std::uint32_t t = this->root;
+        insertSub(value, t, inserted);
+        this->root = t;
+        if (inserted) {
+            this->count++;
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: remove(const Comparable& value)
+    // PreCondition: Comparable value passed by reference
+    // PostCondition: removes value from the tree if it is there, balancing it as well
+    //---------------------------------------------------------
+    void remove(const Comparable& value) {
+        bool removed = false;
+        std::uint32_t t = this->root;
+        removeSub(value, t, removed);
+        this->root = t;
+        if (removed) {
+            this->count--;
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: find_min()
+    // PreCondition: tree is not empty
+    // PostCondition: returns the minimum value in the tree
+    //---------------------------------------------------------
+    const Comparable& find_min() const {
+        if (this->root == NIL) {
+            throw std::invalid_argument("CompactAVLTree is empty");
+        }
+        std::uint32_t current = this->root;
+        while (leftOf(current) != NIL) { // get to leftmost node
+            current = leftOf(current);
+        }
+        return this->nodes[current].data;
+    }
+
+    //-------------------------------------------------------
+    // Name: find_max()
+    // PreCondition: tree is not empty
+    // PostCondition: returns the maximum value in the tree
+    //---------------------------------------------------------
+    const Comparable& find_max() const {
+        if (this->root == NIL) {
+            throw std::invalid_argument("CompactAVLTree is empty");
+        }
+        std::uint32_t current = this->root;
+        while (rightOf(current) != NIL) { // get to rightmost node
+            current = rightOf(current);
+        }
+        return this->nodes[current].data;
+    }
+
+    //-------------------------------------------------------
+    // Name: print_tree(std::ostream& os=std::cout)
+    // PreCondition: ostream os defaults to cout if none given
+    // PostCondition: prints 90 degree rotated tree to os
+    //---------------------------------------------------------
+    void print_tree(std::ostream& os=std::cout) const {
+        if (!is_empty()) {
+            TreeWriter out(os);
+            printTreeLine(this->root, 0, out);
+        }
+        else { // empty tree
+            os << "<empty>\n";
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: is_empty()
+    // PreCondition: none
+    // PostCondition: returns true if tree is empty, false if it isnt
+    //---------------------------------------------------------
+    bool is_empty() const { return (this->root == NIL); }
+
+    //-------------------------------------------------------
+    // Name: size()
+    // PreCondition: none
+    // PostCondition: returns the number of values in the tree
+    //---------------------------------------------------------
+    std::size_t size() const { return this->count; }
+
+    //-------------------------------------------------------
+    // Name: reserve(std::size_t n)
+    // PreCondition: none
+    // PostCondition: makes room for n nodes so the next inserts do not move the vector
+    //---------------------------------------------------------
+    void reserve(std::size_t n) { this->nodes.reserve(n); }
+
+    //-------------------------------------------------------
+    // Name: make_empty()
+    // PreCondition: none
+    // PostCondition: removes every value, keeping the vector's capacity for reuse
+    //---------------------------------------------------------
+    void make_empty() {
+        this->nodes.clear();
+        this->root = NIL;
+        this->freeList = NIL;
+        this->count = 0;
+    }
+};
+
+#endif
@@ -0,0 +1,105 @@
+/*****************************************
+** File:    compact_avl_tree_tests.cpp
+** Project: CSCE 221 Lab 4 Spring 2022
+** Author:  Naimur Rahman
+** Date:    03/21/2022
+** Section: 511
+** E-mail:  naimurrah01@tamu.edu
+** Description: Tests for CompactAVLTree Class
+**/
+#include <iostream>
+#include "compact_avl_tree.h"
+
+using std::cout, std::endl;
+
+int main() {
+    CompactAVLTree<int> t;
+
+    // fail min/max test:
+    try {
+        t.find_min();
+    }
+    catch (const std::invalid_argument&) {
+        cout << "Invalid min test success" << endl;
+    }
+    try {
+        t.find_max();
+    }
+    catch (const std::invalid_argument&) {
+        cout << "Invalid max test success" << endl;
+    }
+    cout << "printing empty tree: " << endl;
+    t.print_tree();
+    cout << "Empty? should be 1: " << t.is_empty() << endl;
+    cout << endl;
+
+    // inserting, 1 to 7 in order should come out perfectly balanced
+    for (int i = 1; i <= 7; i++) {
+        t.insert(i);
+    }
+    t.print_tree();
+    cout << "Size: should be 7: " << t.size() << endl;
+    cout << "Min: should be 1: " << t.find_min() << endl;
+    cout << "Max: should be 7: " << t.find_max() << endl;
+    t.insert(4);
+    cout << "Size after inserting 4 again: should be 7: " << t.size() << endl;
+    cout << endl;
+
+    // removing
+    cout << "Removing 4(Root)" << endl;
+    t.remove(4);
+    t.print_tree();
+    cout << "Removing 1, 2, 3" << endl;
+    t.remove(1);
+    t.remove(2);
+    t.remove(3);
+    t.print_tree();
+    cout << "Size: should be 3: " << t.size() << endl;
+    cout << "Contains 3: should be 0: " << t.contains(3) << endl;
+    cout << "Contains 6: should be 1: " << t.contains(6) << endl;
+    cout << endl;
+
+    // removed nodes are reused
+    t.insert(1);
+    t.insert(2);
+    cout << "Min after reinserting: should be 1: " << t.find_min() << endl;
+
+    // copying and emptying
+    CompactAVLTree<int> cop(t);
+    t.make_empty();
+    cout << "Empty after make_empty: should be 1: " << t.is_empty() << endl;
+    cout << "Copy size: should be 5: " << cop.size() << endl;
+    cop.print_tree();
+    cout << endl;
+
+    // bigger tree against what it should hold
+    CompactAVLTree<int> big;
+    big.reserve(10000);
+    for (int i = 0; i < 10000; i++) {
+        big.insert((i * 7919) % 10000);
+    }
+    for (int i = 0; i < 10000; i += 2) {
+        big.remove(i);
+    }
+    int wrong = 0;
+    for (int i = 0; i < 10000; i++) {
+        if (big.contains(i) != (i % 2 == 1)) {
+            wrong++;
+        }
+    }
+    cout << "Wrong answers after 10000 inserts and 5000 removes: should be 0: " << wrong << endl;
+    cout << "Size: should be 5000: " << big.size() << endl;
+    cout << "Min: should be 1: " << big.find_min() << endl;
+    cout << "Max: should be 9999: " << big.find_max() << endl;
+
+    // char tree
+    CompactAVLTree<char> ct;
+    ct.insert('c');
+    ct.insert('a');
+    ct.insert('z');
+    ct.insert('b');
+    ct.print_tree();
+    cout << "Min val: should be a: " << ct.find_min() << endl;
+    cout << "Max val: should be z: " << ct.find_max() << endl;
+    return 0;
+}
@@ -7,10 +7,29 @@
 ** E-mail:  naimurrah01@tamu.edu
 ** Description: Tests compilation of BinarySearchTree and AVLTree Classes
 **/
+#include <sstream>
 #include "binary_search_tree.h"
 #include "avl_tree.h"
+#include "compact_avl_tree.h"
+#include "persistent_avl_tree.h"
+#include "concurrent_binary_search_tree.h"
+#include "bplus_tree.h"
+#include "tree_map.h"
+#include "mapped_tree.h"
+#include "three_way.h"
+#include "tree_file.h"
+#include "tree_print.h"
 #include "binary_search_tree.h"
 #include "avl_tree.h"
+#include "compact_avl_tree.h"
+#include "persistent_avl_tree.h"
+#include "concurrent_binary_search_tree.h"
+#include "bplus_tree.h"
+#include "tree_map.h"
+#include "mapped_tree.h"
+#include "three_way.h"
+#include "tree_file.h"
+#include "tree_print.h"
 
 struct ComparableValue {
     int value;
@@ -38,6 +57,29 @@ struct ComparableValue {
     }
 };
 
+// only print_tree() and export_tree() need values to print
+std::ostream& operator<<(std::ostream& os, const ComparableValue& v) {
+    return os << v.value;
+}
+
+struct MoveOnlyValue {
+    int value;
+
+    explicit MoveOnlyValue(int value) : value{value} {}
+    MoveOnlyValue(MoveOnlyValue&&) = default;
+    MoveOnlyValue& operator=(MoveOnlyValue&&) = default;
+
+    bool operator<(const MoveOnlyValue& rhs) const { 
+        return value < rhs.value; 
+    }
+    bool operator>(const MoveOnlyValue& rhs) const { 
+        return rhs < *this; 
+    }
+    bool operator==(const MoveOnlyValue& rhs) const { 
+        return !(*this < rhs) && !(rhs < *this); 
+    }
+};
+
 int main() {
     // BST
     {
@@ -62,6 +104,15 @@ int main() {
         tree.remove(ComparableValue(1));
     }
     
+
+    {
+        BinarySearchTree<MoveOnlyValue> tree;
+        tree.insert(MoveOnlyValue(2));
+        tree.emplace(1);
+        BinarySearchTree<MoveOnlyValue> moved(std::move(tree));
+        tree = std::move(moved);
+        tree.remove(MoveOnlyValue(1));
+    }
     
     // AVL
     {
@@ -85,4 +136,202 @@ int main() {
         tree.find_max();
         tree.remove(ComparableValue(1));
     }
+
+    {
+        AVLTree<MoveOnlyValue> tree;
+        tree.insert(MoveOnlyValue(2));
+        tree.emplace(1);
+        AVLTree<MoveOnlyValue> moved(std::move(tree));
+        tree = std::move(moved);
+        tree.remove(MoveOnlyValue(1));
+    }
+    
+    // Compact AVL
+    {
+        CompactAVLTree<int> tree;
+        tree.insert(2);
+        tree.insert(1);
+        tree.insert(3);
+        tree.contains(4);
+        tree.find_min();
+        tree.find_max();
+        tree.remove(1);
+    }
+    
+    {
+        CompactAVLTree<ComparableValue> tree;
+        tree.insert(ComparableValue(2));
+        tree.insert(ComparableValue(1));
+        tree.insert(ComparableValue(3));
+        tree.contains(ComparableValue(4));
+        tree.find_min();
+        tree.find_max();
+        tree.remove(ComparableValue(1));
+    }
+    
+    // Persistent AVL
+    {
+        PersistentAVLTree<int> tree;
+        tree.insert(2);
+        tree.insert(1);
+        tree.insert(3);
+        tree.contains(4);
+        tree.find_min();
+        tree.find_max();
+        tree.remove(1);
+        PersistentAVLTree<int>::Snapshot snap = tree.snapshot();
+        snap.contains(2);
+        snap.size();
+        for (int v : snap) {
+            (void)v;
+        }
+        tree.make_empty();
+    }
+    
+    {
+        PersistentAVLTree<ComparableValue> tree;
+        tree.insert(ComparableValue(2));
+        tree.insert(ComparableValue(1));
+        tree.insert(ComparableValue(3));
+        tree.contains(ComparableValue(4));
+        tree.find_min();
+        tree.find_max();
+        tree.remove(ComparableValue(1));
+    }
+    
+    // Concurrent BST
+    {
+        ConcurrentBinarySearchTree<int> tree;
+        tree.insert(2);
+        tree.insert(1);
+        tree.insert(3);
+        tree.contains(4);
+        tree.find_min();
+        tree.find_max();
+        tree.remove(1);
+        tree.compact();
+    }
+    
+    {
+        ConcurrentBinarySearchTree<ComparableValue> tree;
+        tree.insert(ComparableValue(2));
+        tree.insert(ComparableValue(1));
+        tree.insert(ComparableValue(3));
+        tree.contains(ComparableValue(4));
+        tree.find_min();
+        tree.find_max();
+        tree.remove(ComparableValue(1));
+    }
+    
+    // B+ tree
+    {
+        BPlusTree<int> tree;
+        tree.insert(2);
+        tree.insert(1);
+        tree.insert(3);
+        tree.contains(4);
+        tree.find_min();
+        tree.find_max();
+        tree.remove(1);
+        BPlusTree<int> copy(tree);
+        copy = std::move(tree);
+    }
+    
+    {
+        BPlusTree<ComparableValue, 64, HeapAllocator> tree;
+        tree.insert(ComparableValue(2));
+        tree.insert(ComparableValue(1));
+        tree.insert(ComparableValue(3));
+        tree.contains(ComparableValue(4));
+        tree.find_min();
+        tree.find_max();
+        tree.remove(ComparableValue(1));
+    }
+    
+    // Frozen trees
+    {
+        AVLTree<int> avl;
+        avl.insert(2);
+        BinarySearchTree<ComparableValue> bst;
+        bst.insert(ComparableValue(1));
+        FrozenTree<int> a = avl.freeze();
+        FrozenTree<ComparableValue> b = bst.freeze();
+        a.contains(2);
+        a.lower_bound(1);
+        b.contains(ComparableValue(1));
+        b.find_min();
+        b.find_max();
+    }
+    // Batched lookups
+    {
+        AVLTree<ComparableValue> avl;
+        avl.insert(ComparableValue(1));
+        std::vector<ComparableValue> values = {ComparableValue(1), ComparableValue(2)};
+        std::vector<bool> found;
+        avl.contains_batch(values.begin(), values.end(), std::back_inserter(found));
+    }
+    // Maps
+    {
+        AVLMap<ComparableValue, MoveOnlyValue> a;
+        a.try_emplace(ComparableValue(1), 1);
+        a.insert_or_assign(ComparableValue(1), MoveOnlyValue(2));
+        a.find(ComparableValue(1))->second.value++;
+        a.contains(ComparableValue(2));
+        a.erase(ComparableValue(1));
+        BSTMap<ComparableValue, ComparableValue> b;
+        b[ComparableValue(1)] = ComparableValue(2);
+        b.try_emplace(ComparableValue(2));
+        b.erase(ComparableValue(2));
+        BSTMap<ComparableValue, ComparableValue> c(b);
+        c.size();
+    }
+    // Comparators
+    {
+        struct ByValueDown {
+            bool operator()(const ComparableValue& a, const ComparableValue& b) const { return b < a; }
+        };
+        AVLTree<ComparableValue, NodePool, ByValueDown> avl((ByValueDown()));
+        avl.insert(ComparableValue(1));
+        avl.contains(ComparableValue(1));
+        avl.find(ComparableValue(1));
+        avl.key_comp();
+        avl.freeze().contains(ComparableValue(1));
+        BinarySearchTree<ComparableValue, HeapAllocator, ByValueDown> bst;
+        bst.insert(ComparableValue(2));
+        bst.remove(ComparableValue(2));
+        AVLMap<int, ComparableValue, HeapAllocator, std::greater<int>> map;
+        map[1] = ComparableValue(1);
+        three_way(std::less<>(), 1, 2L);
+    }
+    // Tree files
+    {
+        AVLTree<ComparableValue> avl;
+        avl.insert(ComparableValue(1));
+        avl.save("compile_test.tree");
+        avl.load("compile_test.tree");
+        BinarySearchTree<ComparableValue, HeapAllocator> bst;
+        bst.load("compile_test.tree");
+        bst.save("compile_test.tree");
+        MappedTree<ComparableValue> mapped("compile_test.tree");
+        mapped.contains(ComparableValue(1));
+        mapped.find_min();
+        mapped.find_max();
+        mapped.lower_bound(ComparableValue(0));
+        MappedTree<ComparableValue> moved(std::move(mapped));
+        std::remove("compile_test.tree");
+    }
+    // Export formats
+    {
+        AVLTree<ComparableValue> avl;
+        avl.insert(ComparableValue(1));
+        std::ostringstream os;
+        avl.export_tree(os, TreeFormat::Dot);
+        avl.export_tree(os, TreeFormat::Json, 3);
+        BinarySearchTree<ComparableValue, HeapAllocator> bst;
+        bst.insert(ComparableValue(1));
+        bst.export_tree(os, TreeFormat::LevelOrder);
+        bst.export_tree(os, TreeFormat::Rotated, 0);
+        TreeWriter out(os);
+        out.value(ComparableValue(2)).quoted(ComparableValue(3)).jsonValue(4.5).endLine();
+    }
 }
@@ -0,0 +1,601 @@
+/*****************************************
+** File:    concurrent_binary_search_tree.h
+** Project: CSCE 221 Lab 4 Spring 2022
+** Author:  Naimur Rahman
+** Date:    03/21/2022
+** Section: 511
+** E-mail:  naimurrah01@tamu.edu
+** Description: Implementation for ConcurrentBinarySearchTree class, a BinarySearchTree many threads can change at once
+**/
+#ifndef CONCURRENT_BINARY_SEARCH_TREE_H
+#define CONCURRENT_BINARY_SEARCH_TREE_H
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "tree_print.h"
+using std::cout, std::endl;
+
+// Same set of operations as BinarySearchTree, safe to call insert(), remove()
+// and contains() from any number of threads at once. Searches take no lock;
+// changes lock only the one or two nodes they touch, and a node's key never
+// changes once it is linked in, so a search always ends up where it should:
+//   - insert() locks the node it hangs the new leaf from and checks the spot
+//     is still empty and the node still in the tree, retrying if not.
+//   - remove() locks the node and its parent. A node with at most one child is
+//     unlinked, its child taking its place; a node with two children is only
+//     marked absent (a tombstone) and keeps routing searches to its subtrees
+//     until one of them empties, when it is unlinked the same way.
+// An unlinked node may still be under a search that started before, so it is
+// freed only once every operation that could have seen it has finished, found
+// with reader epochs as in PersistentAVLTree. compact() rebuilds the tree
+// balanced while no other thread is using it; like BinarySearchTree the tree is
+// not balanced in between, so sorted input makes it deep.
+template <typename Comparable>
+class ConcurrentBinarySearchTree {
+private:
+    static const std::size_t READER_STRIPES = 16; // reader counters, spread so readers rarely share a cache line
+    static const std::size_t RECLAIM_BATCH = 1024; // unlinked nodes gathered before waiting out readers to free them
+
+    struct Node;
+
+    // what every node has apart from its value, also the head the root hangs from
+    struct Links {
+        std::atomic<Node*> left{nullptr};
+        std::atomic<Node*> right{nullptr};
+        std::atomic<bool> locked{false}; // held by the thread changing the links of this node
+        bool unlinked = false;           // out of the tree, links fixed for good; set and read under the lock
+
+        void lock() {
+            while (this->locked.exchange(true, std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+        }
+        void unlock() { this->locked.store(false, std::memory_order_release); }
+    };
+
+    // Node Struct for tree, data fixed once linked in
+    struct Node : Links {
+        Comparable data;
+        std::atomic<bool> present{true}; // false once removed
+
+        explicit Node(const Comparable& data) : data(data) {}
+    };
+
+    // readers inside an operation, split by the parity of the epoch they entered under
+    struct alignas(64) ReaderCount {
+        std::atomic<long> active[2] = {{0}, {0}};
+    };
+
+    Links head;                        // root of the tree is head.left
+    std::atomic<std::size_t> count{0}; // number of values present, tombstones not counted
+    std::atomic<std::size_t> nodes{0}; // number of nodes linked in, tombstones included
+    std::atomic<unsigned> epoch{0};    // flipped by the thread freeing unlinked nodes
+    mutable ReaderCount readers[READER_STRIPES];
+    std::mutex retiredLock;                  // guards retired
+    std::vector<Node*> retired;              // unlinked nodes not freed yet
+    std::atomic<std::size_t> retiredCount{0}; // size of retired, read without the lock
+    std::mutex reclaiming;                   // one thread frees unlinked nodes at a time
+
+    // read section helpers
+
+    //-------------------------------------------------------
+    // Name: stripe()
+    // PreCondition:  none
+    // PostCondition: returns the reader counter this thread uses
+    //---------------------------------------------------------
+    static std::size_t stripe() {
+        static thread_local const std::size_t mine = std::hash<std::thread::id>()(std::this_thread::get_id()) % READER_STRIPES;
+        return mine;
+    }
+
+    // marks the calling thread as inside an operation for as long as it lives, so no node it can reach is freed
+    class ReadGuard {
+    private:
+        std::atomic<long>& active;
+
+    public:
+        explicit ReadGuard(const ConcurrentBinarySearchTree& tree)
+            : active(tree.readers[stripe()].active[tree.epoch.load() & 1]) {
+            this->active.fetch_add(1);
+        }
+        ~ReadGuard() { this->active.fetch_sub(1, std::memory_order_release); }
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+    };
+
+    //-------------------------------------------------------
+    // Name: waitForReaders()
+    // PreCondition:  reclaiming held, calling thread not inside a ReadGuard
+    // PostCondition: returns once every operation that started before the call has finished. The epoch is
+    //                flipped twice, as a reader can read the epoch before one flip and count itself after it.
+    //---------------------------------------------------------
+    void waitForReaders() {
+        for (int phase = 0; phase < 2; phase++) {
+            unsigned old = this->epoch.fetch_add(1) & 1;
+            for (ReaderCount& r : this->readers) {
+                while (r.active[old].load(std::memory_order_acquire) != 0) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: retire(Node* n)
+    // PreCondition:  node n just unlinked
+    // PostCondition: queues n to be freed once no operation can reach it
+    //---------------------------------------------------------
+    void retire(Node* n) {
+        std::lock_guard<std::mutex> guard(this->retiredLock);
+        this->retired.push_back(n);
+        this->retiredCount.store(this->retired.size(), std::memory_order_relaxed);
+    }
+
+    //-------------------------------------------------------
+    // Name: reclaim()
+    // PreCondition:  calling thread not inside a ReadGuard
+    // PostCondition: frees the unlinked nodes once RECLAIM_BATCH of them have gathered, unless another thread
+    //                is freeing them already
+    //---------------------------------------------------------
+    void reclaim() {
+        if (this->retiredCount.load(std::memory_order_relaxed) < RECLAIM_BATCH) {
+            return;
+        }
+        std::unique_lock<std::mutex> turn(this->reclaiming, std::try_to_lock);
+        if (!turn.owns_lock()) {
+            return;
+        }
+        std::vector<Node*> batch;
+        {
+            std::lock_guard<std::mutex> guard(this->retiredLock);
+            batch.swap(this->retired);
+            this->retiredCount.store(0, std::memory_order_relaxed);
+        }
+        waitForReaders(); // every node of batch was unlinked before this, so no one reaches it after
+        for (Node* n : batch) {
+            delete n;
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: freeRetired()
+    // PreCondition:  no other thread is using the tree
+    // PostCondition: frees every unlinked node
+    //---------------------------------------------------------
+    void freeRetired() {
+        for (Node* n : this->retired) {
+            delete n;
+        }
+        this->retired.clear();
+        this->retiredCount.store(0);
+    }
+
+    // node helpers
+
+    //-------------------------------------------------------
+    // Name: findNode(const Comparable& value)
+    // PreCondition: Comparable value given, inside a ReadGuard
+    // PostCondition: returns the node holding value, present or not, or nullptr if there is none
+    //---------------------------------------------------------
+    Node* findNode(const Comparable& value) const {
+        Node* current = this->head.left.load(std::memory_order_acquire);
+        while (current != nullptr) {
+            if (value < current->data) { // shift left
+                current = current->left.load(std::memory_order_acquire);
+            }
+            else if (current->data < value) { // shift right
+                current = current->right.load(std::memory_order_acquire);
+            }
+            else {
+                return current;
+            }
+        }
+        return nullptr;
+    }
+
+    //-------------------------------------------------------
+    // Name: findWithParent(const Comparable& value, Links*& parent)
+    // PreCondition: Comparable value given, inside a ReadGuard
+    // PostCondition: returns the node holding value, or nullptr if there is none, with parent set to the
+    //                node or head it was reached from
+    //---------------------------------------------------------
+    Node* findWithParent(const Comparable& value, Links*& parent) {
+        parent = &this->head;
+        Node* current = this->head.left.load(std::memory_order_acquire);
+        while (current != nullptr) {
+            if (value < current->data) { // shift left
+                parent = current;
+                current = current->left.load(std::memory_order_acquire);
+            }
+            else if (current->data < value) { // shift right
+                parent = current;
+                current = current->right.load(std::memory_order_acquire);
+            }
+            else {
+                break;
+            }
+        }
+        return current;
+    }
+
+    //-------------------------------------------------------
+    // Name: linkedUnder(Links* parent, Node* n)
+    // PreCondition: parent and n locked
+    // PostCondition: returns true if both are still in the tree and n is a child of parent
+    //---------------------------------------------------------
+    static bool linkedUnder(Links* parent, Node* n) {
+        return !parent->unlinked && !n->unlinked &&
+               (parent->left.load(std::memory_order_relaxed) == n || parent->right.load(std::memory_order_relaxed) == n);
+    }
+
+    //-------------------------------------------------------
+    // Name: unlinkLocked(Links* parent, Node* n)
+    // PreCondition: parent and n locked, n a child of parent with at most one child and not present
+    // PostCondition: puts the child of n in its place and returns parent if it is now a tombstone with at most
+    //                one child, to be unlinked in turn, nullptr if not
+    //---------------------------------------------------------
+    Node* unlinkLocked(Links* parent, Node* n) {
+        Node* child = n->left.load(std::memory_order_relaxed);
+        if (child == nullptr) {
+            child = n->right.load(std::memory_order_relaxed);
+        }
+        n->unlinked = true;
+        if (parent->left.load(std::memory_order_relaxed) == n) {
+            parent->left.store(child, std::memory_order_release);
+        }
+        else {
+            parent->right.store(child, std::memory_order_release);
+        }
+        this->nodes.fetch_sub(1, std::memory_order_relaxed);
+        if (parent == &this->head) {
+            return nullptr;
+        }
+        Node* p = static_cast<Node*>(parent);
+        bool bothChildren = p->left.load(std::memory_order_relaxed) != nullptr && p->right.load(std::memory_order_relaxed) != nullptr;
+        return (!p->present.load(std::memory_order_relaxed) && !bothChildren) ? p : nullptr;
+    }
+
+    //-------------------------------------------------------
+    // Name: unlinkTombstone(Node* target)
+    // PreCondition: tombstone target seen with at most one child, inside a ReadGuard
+    // PostCondition: unlinks target if it is still a tombstone with at most one child, then its parent if that
+    //                became one, and so on up
+    //---------------------------------------------------------
+    void unlinkTombstone(Node* target) {
+        while (target != nullptr) {
+            Links* parent;
+            Node* n = findWithParent(target->data, parent);
+            if (n != target) { // already unlinked
+                return;
+            }
+            parent->lock();
+            n->lock();
+            if (!linkedUnder(parent, n)) { // parent unlinked meanwhile, look again
+                n->unlock();
+                parent->unlock();
+                continue;
+            }
+            if (n->present.load(std::memory_order_relaxed) ||
+                (n->left.load(std::memory_order_relaxed) != nullptr && n->right.load(std::memory_order_relaxed) != nullptr)) {
+                n->unlock(); // inserted again, or given a second child
+                parent->unlock();
+                return;
+            }
+            target = unlinkLocked(parent, n);
+            n->unlock();
+            parent->unlock();
+            retire(n);
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: removeNode(const Comparable& value)
+    // PreCondition: Comparable value given, inside a ReadGuard
+    // PostCondition: removes value and returns true, or returns false if it is not in the tree
+    //---------------------------------------------------------
+    bool removeNode(const Comparable& value) {
+        while (true) {
+            Links* parent;
+            Node* n = findWithParent(value, parent);
+            if (n == nullptr) {
+                return false;
+            }
+            parent->lock(); // always a node before its child, so two threads never wait on each other
+            n->lock();
+            if (!linkedUnder(parent, n)) { // changed since the search, look again
+                n->unlock();
+                parent->unlock();
+                continue;
+            }
+            if (!n->present.load(std::memory_order_relaxed)) { // already a tombstone
+                n->unlock();
+                parent->unlock();
+                return false;
+            }
+            n->present.store(false, std::memory_order_release);
+            this->count.fetch_sub(1, std::memory_order_relaxed);
+            bool bothChildren = n->left.load(std::memory_order_relaxed) != nullptr && n->right.load(std::memory_order_relaxed) != nullptr;
+            Node* next = bothChildren ? nullptr : unlinkLocked(parent, n);
+            n->unlock();
+            parent->unlock();
+            if (!bothChildren) {
+                retire(n);
+                unlinkTombstone(next);
+            }
+            return true;
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: collectNodes(Node* t, std::vector<Node*>& out)
+    // PreCondition: tree t that no other thread is using
+    // PostCondition: appends every node of t to out in order, without recursing
+    //---------------------------------------------------------
+    static void collectNodes(Node* t, std::vector<Node*>& out) {
+        std::vector<Node*> path;
+        while (t != nullptr || !path.empty()) {
+            while (t != nullptr) { // go as far left as possible
+                path.push_back(t);
+                t = t->left.load(std::memory_order_relaxed);
+            }
+            t = path.back();
+            path.pop_back();
+            out.push_back(t);
+            t = t->right.load(std::memory_order_relaxed);
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: relinkNodes(Node* const* nodes, std::size_t n)
+    // PreCondition: n nodes in order
+    // PostCondition: links the nodes into a perfectly balanced tree and returns its root
+    //---------------------------------------------------------
+    static Node* relinkNodes(Node* const* nodes, std::size_t n) {
+        if (n == 0) {
+            return nullptr;
+        }
+        std::size_t mid = n / 2;
+        Node* t = nodes[mid];
+        t->left.store(relinkNodes(nodes, mid), std::memory_order_relaxed);
+        t->right.store(relinkNodes(nodes + mid + 1, n - mid - 1), std::memory_order_relaxed);
+        return t;
+    }
+
+    //-------------------------------------------------------
+    // Name: firstPresent(bool last)
+    // PreCondition: inside a ReadGuard
+    // PostCondition: returns the smallest present node, or the largest if last is true, nullptr if there is none
+    //---------------------------------------------------------
+    Node* firstPresent(bool last) const {
+        std::vector<Node*> path;
+        Node* t = this->head.left.load(std::memory_order_acquire);
+        while (t != nullptr || !path.empty()) {
+            while (t != nullptr) { // go as far towards the end asked for as possible
+                path.push_back(t);
+                t = (last ? t->right : t->left).load(std::memory_order_acquire);
+            }
+            t = path.back();
+            path.pop_back();
+            if (t->present.load(std::memory_order_acquire)) {
+                return t;
+            }
+            t = (last ? t->left : t->right).load(std::memory_order_acquire);
+        }
+        return nullptr;
+    }
+
+public:
+    //-------------------------------------------------------
+    // Name: ConcurrentBinarySearchTree()
+    // PreCondition: none
+    // PostCondition: creates new empty ConcurrentBinarySearchTree object
+    //---------------------------------------------------------
+    ConcurrentBinarySearchTree() = default;
+
+    // other threads may hold on to the tree itself, so it can't be copied or moved
+    ConcurrentBinarySearchTree(const ConcurrentBinarySearchTree&) = delete;
+    ConcurrentBinarySearchTree& operator=(const ConcurrentBinarySearchTree&) = delete;
+
+    //-------------------------------------------------------
+    // Name: ~ConcurrentBinarySearchTree()
+    // PreCondition: no other thread is using the tree
+    // PostCondition: frees every node, tombstones and unlinked nodes included
+    //---------------------------------------------------------
+    ~ConcurrentBinarySearchTree() {
+        make_empty();
+    }
+
+    //-------------------------------------------------------
+    // Name: contains(const Comparable& value)
+    // PreCondition: Comparable value passed by reference
+    // PostCondition: return true if value is in tree, false if not. Never blocks.
+    //---------------------------------------------------------
+    bool contains(const Comparable& value) const {
+        ReadGuard guard(*this);
+        Node* n = findNode(value);
+        return n != nullptr && n->present.load(std::memory_order_acquire);
+    }
+
+    //-------------------------------------------------------
+    // Name: insert(const Comparable& value)
+    // PreCondition: Comparable value passed by reference
+    // PostCondition: adds value and returns true, or returns false if it is already in the tree
+    //---------------------------------------------------------
+    bool insert(const Comparable& value) {
+        ReadGuard guard(*this);
+        Node* fresh = nullptr; // built at most once, kept across retries
+        while (true) {
+            Links* parent;
+            Node* current = findWithParent(value, parent);
+            if (current == nullptr) { // empty spot for value under parent, try to take it
+                if (fresh == nullptr) {
+                    fresh = new Node(value);
+                }
+                std::atomic<Node*>& link = (parent != &this->head && static_cast<Node*>(parent)->data < value) ? parent->right : parent->left;
+                parent->lock();
+                if (!parent->unlinked && link.load(std::memory_order_relaxed) == nullptr) {
+                    link.store(fresh, std::memory_order_release);
+                    parent->unlock();
+                    this->nodes.fetch_add(1, std::memory_order_relaxed);
+                    this->count.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+                parent->unlock(); // another thread got there first, or parent was unlinked, look again
+                continue;
+            }
+            // node for value exists, bring it back if it was removed
+            delete fresh;
+            fresh = nullptr;
+            current->lock();
+            if (current->unlinked) { // unlinked since the search, look again
+                current->unlock();
+                continue;
+            }
+            bool removed = !current->present.load(std::memory_order_relaxed);
+            if (removed) {
+                current->present.store(true, std::memory_order_release);
+                this->count.fetch_add(1, std::memory_order_relaxed);
+            }
+            current->unlock();
+            return removed;
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: remove(const Comparable& value)
+    // PreCondition: Comparable value passed by reference
+    // PostCondition: removes value and returns true, or returns false if it was not in the tree
+    //---------------------------------------------------------
+    bool remove(const Comparable& value) {
+        bool removed;
+        {
+            ReadGuard guard(*this);
+            removed = removeNode(value);
+        }
+        reclaim();
+        return removed;
+    }
+
+    //-------------------------------------------------------
+    // Name: find_min()
+    // PreCondition: tree holds a value
+    // PostCondition: returns a copy of the minimum value, one that was present at some point during the call
+    //---------------------------------------------------------
+    Comparable find_min() const {
+        ReadGuard guard(*this);
+        Node* n = firstPresent(false);
+        if (n == nullptr) {
+            throw std::invalid_argument("Tree is Empty");
+        }
+        return n->data;
+    }
+
+    //-------------------------------------------------------
+    // Name: find_max()
+    // PreCondition: tree holds a value
+    // PostCondition: returns a copy of the maximum value, one that was present at some point during the call
+    //---------------------------------------------------------
+    Comparable find_max() const {
+        ReadGuard guard(*this);
+        Node* n = firstPresent(true);
+        if (n == nullptr) {
+            throw std::invalid_argument("Tree is Empty");
+        }
+        return n->data;
+    }
+
+    //-------------------------------------------------------
+    // Name: is_empty()
+    // PreCondition: none
+    // PostCondition: returns true if no value is present, false if one is
+    //---------------------------------------------------------
+    bool is_empty() const {
+        return this->count.load(std::memory_order_relaxed) == 0;
+    }
+
+    //-------------------------------------------------------
+    // Name: size()
+    // PreCondition: none
+    // PostCondition: returns the number of values present
+    //---------------------------------------------------------
+    std::size_t size() const {
+        return this->count.load(std::memory_order_relaxed);
+    }
+
+    //-------------------------------------------------------
+    // Name: tombstones()
+    // PreCondition: none
+    // PostCondition: returns the number of removed values whose nodes are still in the tree, routing searches
+    //                to two subtrees
+    //---------------------------------------------------------
+    std::size_t tombstones() const {
+        std::size_t n = this->nodes.load(std::memory_order_relaxed);
+        std::size_t c = this->count.load(std::memory_order_relaxed);
+        return (n > c) ? n - c : 0;
+    }
+
+    //-------------------------------------------------------
+    // Name: compact()
+    // PreCondition: no other thread is using the tree
+    // PostCondition: frees every tombstone and relinks the values left into a perfectly balanced tree
+    //---------------------------------------------------------
+    void compact() {
+        freeRetired();
+        std::vector<Node*> all;
+        all.reserve(this->nodes.load());
+        collectNodes(this->head.left.load(), all);
+        std::size_t kept = 0;
+        for (Node* n : all) {
+            if (n->present.load()) {
+                all[kept++] = n;
+            }
+            else {
+                delete n;
+            }
+        }
+        this->head.left.store(relinkNodes(all.data(), kept));
+        this->nodes.store(kept);
+        this->count.store(kept);
+    }
+
+    //-------------------------------------------------------
+    // Name: make_empty()
+    // PreCondition: no other thread is using the tree
+    // PostCondition: frees every node and leaves the tree empty
+    //---------------------------------------------------------
+    void make_empty() {
+        freeRetired();
+        std::vector<Node*> all;
+        collectNodes(this->head.left.load(), all);
+        for (Node* n : all) {
+            delete n;
+        }
+        this->head.left.store(nullptr);
+        this->nodes.store(0);
+        this->count.store(0);
+    }
+
+    //-------------------------------------------------------
+    // Name: print_tree(std::ostream& os=std::cout)
+    // PreCondition: ostream os defaults to cout if none given, no other thread changing the tree
+    // PostCondition: prints 90 degree rotated tree to os, tombstones left out
+    //---------------------------------------------------------
+    void print_tree(std::ostream& os=std::cout) const {
+        if (!is_empty()) {
+            TreeWriter out(os);
+            write_rotated(out, static_cast<const Node*>(this->head.left.load()), NO_DEPTH_LIMIT,
+                          [](const Node& n) { return n.present.load(); });
+        }
+        else { // empty tree
+            os << "<empty>\n";
+        }
+    }
+};
+
+#endif
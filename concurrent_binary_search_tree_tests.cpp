@@ -0,0 +1,207 @@
+/*****************************************
+** File:    concurrent_binary_search_tree_tests.cpp
+** Project: CSCE 221 Lab 4 Spring 2022
+** Author:  Naimur Rahman
+** Date:    03/21/2022
+** Section: 511
+** E-mail:  naimurrah01@tamu.edu
+** Description: Tests for ConcurrentBinarySearchTree Class
+**/
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "concurrent_binary_search_tree.h"
+
+using std::cout, std::endl;
+
+int main() {
+    ConcurrentBinarySearchTree<int> t;
+
+    // fail min/max test:
+    try {
+        t.find_min();
+    }
+    catch (const std::invalid_argument&) {
+        cout << "Invalid min test success" << endl;
+    }
+    try {
+        t.find_max();
+    }
+    catch (const std::invalid_argument&) {
+        cout << "Invalid max test success" << endl;
+    }
+    cout << "printing empty tree: " << endl;
+    t.print_tree();
+    cout << "Empty? should be 1: " << t.is_empty() << endl;
+    cout << endl;
+
+    // inserting
+    int values[] = {4, 2, 6, 1, 3, 5, 7};
+    for (int v : values) {
+        t.insert(v);
+    }
+    t.print_tree();
+    cout << "Size: should be 7: " << t.size() << endl;
+    cout << "Inserting 4 again: should be 0: " << t.insert(4) << endl;
+    cout << "Min: should be 1: " << t.find_min() << endl;
+    cout << "Max: should be 7: " << t.find_max() << endl;
+    cout << endl;
+
+    // removing unlinks nodes with at most one child, and leaves tombstones in nodes with two
+    cout << "Removing 4(Root): should be 1: " << t.remove(4) << endl;
+    cout << "Removing 4 again: should be 0: " << t.remove(4) << endl;
+    t.remove(1);
+    t.remove(7);
+    t.print_tree();
+    cout << "Size: should be 4: " << t.size() << endl;
+    cout << "Tombstones: should be 1: " << t.tombstones() << endl;
+    cout << "Contains 4: should be 0: " << t.contains(4) << endl;
+    cout << "Min: should be 2: " << t.find_min() << endl;
+    cout << "Max: should be 6: " << t.find_max() << endl;
+    cout << "Inserting 4 back: should be 1: " << t.insert(4) << endl;
+    cout << "Tombstones: should be 0: " << t.tombstones() << endl;
+    t.remove(2);
+    t.remove(4);
+    cout << "Tombstones with both subtrees left: should be 1: " << t.tombstones() << endl;
+    t.remove(3);
+    cout << "Tombstones once a subtree empties: should be 0: " << t.tombstones() << endl;
+    t.print_tree();
+    t.insert(2);
+    t.insert(4);
+    t.compact();
+    cout << "After compact" << endl;
+    t.print_tree();
+    cout << "Tombstones: should be 0: " << t.tombstones() << endl;
+    cout << "Size: should be 4: " << t.size() << endl;
+    t.make_empty();
+    cout << "Empty after make_empty: should be 1: " << t.is_empty() << endl;
+    cout << endl;
+
+    // a sorted run makes a list as deep as it is long, which still prints
+    ConcurrentBinarySearchTree<int> list;
+    for (int i = 0; i < 10000; i++) {
+        list.insert(i);
+    }
+    std::ostringstream listText;
+    list.print_tree(listText);
+    std::string text = listText.str();
+    cout << "Lines printed for a 10000 deep list: should be 10000: " << std::count(text.begin(), text.end(), '\n') << endl;
+    for (int i = 0; i < 10000; i += 2) {
+        list.remove(i);
+    }
+    cout << "Tombstones after removing every other value: should be 0: " << list.tombstones() << endl;
+    cout << "Size: should be 5000: " << list.size() << endl;
+    cout << endl;
+
+    // stress test: threads insert and remove overlapping keys at random, counting what succeeded.
+    // A key ends up present exactly when its successful inserts outnumber its successful removes.
+    const int THREADS = 8;
+    const int KEYS = 2000;
+    const int OPS = 50000;
+    ConcurrentBinarySearchTree<int> shared;
+    std::vector<std::vector<int>> balance(THREADS, std::vector<int>(KEYS, 0));
+    std::vector<std::thread> workers;
+    for (int w = 0; w < THREADS; w++) {
+        workers.emplace_back([&shared, &balance, w, KEYS, OPS]() {
+            std::mt19937 gen(w);
+            for (int i = 0; i < OPS; i++) {
+                int key = static_cast<int>(gen() % KEYS);
+                switch (gen() % 3) {
+                    case 0:
+                        balance[w][key] += shared.insert(key);
+                        break;
+                    case 1:
+                        balance[w][key] -= shared.remove(key);
+                        break;
+                    default:
+                        shared.contains(key);
+                        break;
+                }
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    int wrong = 0;
+    std::size_t expected = 0;
+    for (int key = 0; key < KEYS; key++) {
+        int net = 0;
+        for (int w = 0; w < THREADS; w++) {
+            net += balance[w][key];
+        }
+        if ((net != 0 && net != 1) || shared.contains(key) != (net == 1)) {
+            wrong++;
+        }
+        expected += net;
+    }
+    cout << "Keys wrong after " << THREADS << " threads: should be 0: " << wrong << endl;
+    cout << "Size matches: should be 1: " << (shared.size() == expected) << endl;
+    shared.compact();
+    wrong = 0;
+    for (int key = 0; key < KEYS; key++) {
+        int net = 0;
+        for (int w = 0; w < THREADS; w++) {
+            net += balance[w][key];
+        }
+        wrong += shared.contains(key) != (net == 1);
+    }
+    cout << "Keys wrong after compact: should be 0: " << wrong << endl;
+    cout << endl;
+
+    // stress test: threads insert disjoint keys and remove them all again while the others search,
+    // so every node is unlinked and freed while other threads may still be walking past it
+    ConcurrentBinarySearchTree<int> drained;
+    std::vector<int> lookupsWrong(THREADS, 0);
+    workers.clear();
+    for (int w = 0; w < THREADS; w++) {
+        workers.emplace_back([&drained, &lookupsWrong, w, THREADS]() {
+            std::mt19937 gen(w);
+            std::vector<int> mine;
+            for (int i = 0; i < 5000; i++) {
+                mine.push_back(static_cast<int>(gen() % 1000000) * THREADS + w);
+            }
+            for (int round = 0; round < 4; round++) {
+                for (int key : mine) {
+                    drained.insert(key);
+                }
+                for (int key : mine) {
+                    lookupsWrong[w] += !drained.contains(key);
+                    drained.contains(key + 1); // a key of another thread, in any state
+                }
+                for (int key : mine) {
+                    drained.remove(key);
+                }
+                for (int key : mine) {
+                    lookupsWrong[w] += drained.contains(key);
+                }
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    wrong = 0;
+    for (int w : lookupsWrong) {
+        wrong += w;
+    }
+    cout << "Lookups wrong while draining: should be 0: " << wrong << endl;
+    cout << "Empty after draining: should be 1: " << drained.is_empty() << endl;
+    cout << "Tombstones after draining: should be 0: " << drained.tombstones() << endl;
+    cout << endl;
+
+    // char tree
+    ConcurrentBinarySearchTree<char> ct;
+    ct.insert('c');
+    ct.insert('a');
+    ct.insert('z');
+    ct.insert('b');
+    ct.print_tree();
+    cout << "Min val: should be a: " << ct.find_min() << endl;
+    cout << "Max val: should be z: " << ct.find_max() << endl;
+    return 0;
+}
@@ -0,0 +1,322 @@
+/*****************************************
+** File:    frozen_tree.h
+** Project: CSCE 221 Lab 4 Spring 2022
+** Author:  Naimur Rahman
+** Date:    03/21/2022
+** Section: 511
+** E-mail:  naimurrah01@tamu.edu
+** Description: Implementation for FrozenTree class, a read-only search tree laid out in one array
+**/
+#ifndef FROZEN_TREE_H
+#define FROZEN_TREE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "tree_print.h"
+using std::cout, std::endl;
+
+// Values of a tree that will not change again, stored in Eytzinger (breadth
+// first) order with no pointers: keys[1] is the root and the children of
+// keys[k] are keys[2k] and keys[2k + 1], keys[0] being unused. A search only
+// computes the next index, k = 2k + (keys[k] < x), so it has no branch to
+// mispredict, and the four levels below k sit together around keys[16k] where
+// they can be prefetched a few steps early. Made by AVLTree::freeze() and
+// BinarySearchTree::freeze(), or straight from a range of values, and ordered
+// by Compare like the tree it was frozen from.
+// Comparable has to be default constructible for the unused keys[0].
+template <typename Comparable, typename Compare = std::less<Comparable>>
+class FrozenTree {
+private:
+    static constexpr std::size_t CACHE_LINE = 64;
+    // keys[k * PREFETCH_STRIDE] is where the search will be four levels down for keys one cache line in size or smaller
+    static constexpr std::size_t PREFETCH_STRIDE = std::max<std::size_t>(1, CACHE_LINE / sizeof(Comparable));
+
+    std::vector<Comparable> keys; // keys[1..n] in Eytzinger order
+    Compare comp; // order of the values
+
+    //-------------------------------------------------------
+    // Name: firstIndex() / lastIndex()
+    // PreCondition:  none
+    // PostCondition: returns the index of the minimum / maximum value, 0 if the tree is empty
+    //---------------------------------------------------------
+    std::size_t firstIndex() const {
+        std::size_t k = 0;
+        for (std::size_t next = 1; next <= size(); next *= 2) { // keep going left
+            k = next;
+        }
+        return k;
+    }
+
+    std::size_t lastIndex() const {
+        std::size_t k = 0;
+        for (std::size_t next = 1; next <= size(); next = 2 * next + 1) { // keep going right
+            k = next;
+        }
+        return k;
+    }
+
+    //-------------------------------------------------------
+    // Name: nextIndex(std::size_t k)
+    // PreCondition:  index k of a value
+    // PostCondition: returns the index of the next value in order, 0 after the maximum
+    //---------------------------------------------------------
+    std::size_t nextIndex(std::size_t k) const {
+        if (2 * k + 1 <= size()) { // leftmost value of the right subtree
+            k = 2 * k + 1;
+            while (2 * k <= size()) {
+                k = 2 * k;
+            }
+            return k;
+        }
+        // climb past every ancestor k is right of, and then one more
+        return k >> __builtin_ffsll(static_cast<long long>(~k));
+    }
+
+    //-------------------------------------------------------
+    // Name: prevIndex(std::size_t k)
+    // PreCondition:  index k of a value, or 0 for one past the maximum
+    // PostCondition: returns the index of the previous value in order, 0 before the minimum
+    //---------------------------------------------------------
+    std::size_t prevIndex(std::size_t k) const {
+        if (k == 0) {
+            return lastIndex();
+        }
+        if (2 * k <= size()) { // rightmost value of the left subtree
+            k = 2 * k;
+            while (2 * k + 1 <= size()) {
+                k = 2 * k + 1;
+            }
+            return k;
+        }
+        // climb past every ancestor k is left of, and then one more
+        return k >> __builtin_ffsll(static_cast<long long>(k));
+    }
+
+    //-------------------------------------------------------
+    // Name: searchIndex<Upper>(const Comparable& x)
+    // PreCondition:  Comparable x given
+    // PostCondition: returns the index of the first value not less than x, or greater than x if Upper is true,
+    //                0 if there is none. The loop has no branch besides its end test.
+    //---------------------------------------------------------
+    template <bool Upper>
+    std::size_t searchIndex(const Comparable& x) const {
+        const Comparable* base = this->keys.data();
+        std::size_t n = size();
+        std::size_t k = 1;
+        while (k <= n) {
+            __builtin_prefetch(base + k * PREFETCH_STRIDE);
+            k = 2 * k + (Upper ? !this->comp(x, base[k]) : this->comp(base[k], x));
+        }
+        // k walked right past the answer every time after it went left at it, so drop those steps and the last left one
+        return k >> __builtin_ffsll(static_cast<long long>(~k));
+    }
+
+    //-------------------------------------------------------
+    // Name: layOut(InputIt first, std::size_t n)
+    // PreCondition:  n values in strictly increasing order starting at first
+    // PostCondition: stores the values in Eytzinger order, filling the indexes in order of their values
+    //---------------------------------------------------------
+    template <typename InputIt>
+    void layOut(InputIt first, std::size_t n) {
+        this->keys.assign(n + 1, Comparable());
+        for (std::size_t k = firstIndex(); k != 0; k = nextIndex(k)) {
+            this->keys[k] = *first;
+            ++first;
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: printTreeLine(std::size_t k, int space, TreeWriter& out)
+    // PreCondition:  index k given with value for space, and the TreeWriter out collecting the text
+    // PostCondition: recursively prints tree rotated to out 90 degrees from index k
+    //---------------------------------------------------------
+    void printTreeLine(std::size_t k, int space, TreeWriter& out) const {
+        if (k > size()) {
+            return;
+        }
+        space++; // amount of levels
+        printTreeLine(2 * k + 1, space, out);
+        out.indent(2 * (space - 1)).value(this->keys[k]).endLine();
+        printTreeLine(2 * k, space, out);
+    }
+
+public:
+    //-------------------------------------------------------
+    // Name: const_iterator
+    // Description: bidirectional in-order iterator over the values, stepping between array indexes
+    //---------------------------------------------------------
+    class const_iterator {
+    private:
+        const FrozenTree* tree; // tree walked
+        std::size_t k;          // index of the current value, 0 once past the end
+
+        const_iterator(const FrozenTree* tree, std::size_t k) : tree(tree), k(k) {}
+        friend class FrozenTree;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = Comparable;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Comparable*;
+        using reference = const Comparable&;
+
+        const_iterator() : tree(nullptr), k(0) {}
+
+        reference operator*() const { return this->tree->keys[this->k]; }
+        pointer operator->() const { return &this->tree->keys[this->k]; }
+
+        const_iterator& operator++() {
+            this->k = this->tree->nextIndex(this->k);
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++(*this);
+            return old;
+        }
+
+        const_iterator& operator--() {
+            this->k = this->tree->prevIndex(this->k);
+            return *this;
+        }
+
+        const_iterator operator--(int) {
+            const_iterator old = *this;
+            --(*this);
+            return old;
+        }
+
+        bool operator==(const const_iterator& rhs) const { return this->k == rhs.k; }
+        bool operator!=(const const_iterator& rhs) const { return this->k != rhs.k; }
+    };
+
+    using iterator = const_iterator;
+
+    //-------------------------------------------------------
+    // Name: FrozenTree()
+    // PreCondition: none
+    // PostCondition: creates an empty FrozenTree
+    //---------------------------------------------------------
+    FrozenTree() = default;
+
+    //-------------------------------------------------------
+    // Name: FrozenTree(InputIt first, InputIt last, const Compare& comp = Compare())
+    // PreCondition: range of values first to last given, and a comparator comp if not the default one
+    // PostCondition: creates a FrozenTree holding the values of the range in the order of comp. Strictly
+    //                sorted forward iterator input, such as another tree's, is laid out straight from the
+    //                range, anything else is copied, sorted and deduplicated first.
+    //---------------------------------------------------------
+    template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    FrozenTree(InputIt first, InputIt last, const Compare& comp = Compare()) : comp(comp) {
+        auto notBefore = [this](const Comparable& a, const Comparable& b) { return !this->comp(a, b); };
+        if constexpr (std::is_base_of<std::forward_iterator_tag,
+                                      typename std::iterator_traits<InputIt>::iterator_category>::value) {
+            if (std::adjacent_find(first, last, notBefore) == last) {
+                layOut(first, static_cast<std::size_t>(std::distance(first, last)));
+                return;
+            }
+        }
+        std::vector<Comparable> values(first, last);
+        std::sort(values.begin(), values.end(), this->comp);
+        values.erase(std::unique(values.begin(), values.end(), notBefore), values.end()); // sorted, so a is not after b
+        layOut(values.begin(), values.size());
+    }
+
+    //-------------------------------------------------------
+    // Name: contains(const Comparable& value)
+    // PreCondition: Comparable value passed by reference
+    // PostCondition: return true if value is in the tree, false if not
+    //---------------------------------------------------------
+    bool contains(const Comparable& value) const {
+        std::size_t k = searchIndex<false>(value);
+        return k != 0 && !this->comp(value, this->keys[k]);
+    }
+
+    //-------------------------------------------------------
+    // Name: lower_bound(const Comparable& value)
+    // PreCondition: Comparable value passed by reference
+    // PostCondition: returns an iterator to the first value not less than value, or end()
+    //---------------------------------------------------------
+    const_iterator lower_bound(const Comparable& value) const {
+        return const_iterator(this, searchIndex<false>(value));
+    }
+
+    //-------------------------------------------------------
+    // Name: upper_bound(const Comparable& value)
+    // PreCondition: Comparable value passed by reference
+    // PostCondition: returns an iterator to the first value greater than value, or end()
+    //---------------------------------------------------------
+    const_iterator upper_bound(const Comparable& value) const {
+        return const_iterator(this, searchIndex<true>(value));
+    }
+
+    //-------------------------------------------------------
+    // Name: find_min()
+    // PreCondition: tree is not empty
+    // PostCondition: returns the minimum value
+    //---------------------------------------------------------
+    const Comparable& find_min() const {
+        if (is_empty()) {
+            throw std::invalid_argument("FrozenTree is empty");
+        }
+        return this->keys[firstIndex()];
+    }
+
+    //-------------------------------------------------------
+    // Name: find_max()
+    // PreCondition: tree is not empty
+    // PostCondition: returns the maximum value
+    //---------------------------------------------------------
+    const Comparable& find_max() const {
+        if (is_empty()) {
+            throw std::invalid_argument("FrozenTree is empty");
+        }
+        return this->keys[lastIndex()];
+    }
+
+    //-------------------------------------------------------
+    // Name: begin() / end()
+    // PreCondition: none
+    // PostCondition: iterators to the minimum value and one past the maximum
+    //---------------------------------------------------------
+    const_iterator begin() const { return const_iterator(this, firstIndex()); }
+    const_iterator end() const { return const_iterator(this, 0); }
+
+    //-------------------------------------------------------
+    // Name: print_tree(std::ostream& os=std::cout)
+    // PreCondition: ostream os defaults to cout if none given
+    // PostCondition: prints 90 degree rotated tree to os
+    //---------------------------------------------------------
+    void print_tree(std::ostream& os=std::cout) const {
+        if (!is_empty()) {
+            TreeWriter out(os);
+            printTreeLine(1, 0, out);
+        }
+        else { // empty tree
+            os << "<empty>\n";
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: is_empty()
+    // PreCondition: none
+    // PostCondition: returns true if tree is empty, false if it isnt
+    //---------------------------------------------------------
+    bool is_empty() const { return size() == 0; }
+
+    //-------------------------------------------------------
+    // Name: size()
+    // PreCondition: none
+    // PostCondition: returns the number of values in the tree
+    //---------------------------------------------------------
+    std::size_t size() const { return this->keys.empty() ? 0 : this->keys.size() - 1; }
+};
+
+#endif
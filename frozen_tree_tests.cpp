@@ -0,0 +1,149 @@
+/*****************************************
+** File:    frozen_tree_tests.cpp
+** Project: CSCE 221 Lab 4 Spring 2022
+** Author:  Naimur Rahman
+** Date:    03/21/2022
+** Section: 511
+** E-mail:  naimurrah01@tamu.edu
+** Description: Tests for FrozenTree Class and freeze()
+**/
+#include <functional>
+#include <iostream>
+#include <vector>
+#include "avl_tree.h"
+#include "binary_search_tree.h"
+#include "frozen_tree.h"
+
+using std::cout, std::endl;
+
+int main() {
+    FrozenTree<int> empty;
+
+    // fail min/max test:
+    try {
+        empty.find_min();
+    }
+    catch (const std::invalid_argument&) {
+        cout << "Invalid min test success" << endl;
+    }
+    try {
+        empty.find_max();
+    }
+    catch (const std::invalid_argument&) {
+        cout << "Invalid max test success" << endl;
+    }
+    cout << "printing empty tree: " << endl;
+    empty.print_tree();
+    cout << "Empty? should be 1: " << empty.is_empty() << endl;
+    cout << "Contains 1: should be 0: " << empty.contains(1) << endl;
+    cout << "begin is end: should be 1: " << (empty.begin() == empty.end()) << endl;
+    cout << endl;
+
+    // freezing an AVLTree
+    AVLTree<int> avl;
+    for (int i = 1; i <= 10; i++) {
+        avl.insert(i * 10);
+    }
+    FrozenTree<int> t = avl.freeze();
+    t.print_tree();
+    cout << "Size: should be 10: " << t.size() << endl;
+    cout << "Min: should be 10: " << t.find_min() << endl;
+    cout << "Max: should be 100: " << t.find_max() << endl;
+    cout << "Contains 50: should be 1: " << t.contains(50) << endl;
+    cout << "Contains 55: should be 0: " << t.contains(55) << endl;
+    cout << "lower_bound(55): should be 60: " << *t.lower_bound(55) << endl;
+    cout << "lower_bound(60): should be 60: " << *t.lower_bound(60) << endl;
+    cout << "upper_bound(60): should be 70: " << *t.upper_bound(60) << endl;
+    cout << "lower_bound(101) is end: should be 1: " << (t.lower_bound(101) == t.end()) << endl;
+    cout << "In order: should be 10 20 30 40 50 60 70 80 90 100: ";
+    for (int v : t) {
+        cout << v << ' ';
+    }
+    cout << endl;
+    cout << "Backwards from end: should be 100 90 80: ";
+    FrozenTree<int>::const_iterator it = t.end();
+    for (int i = 0; i < 3; i++) {
+        cout << *--it << ' ';
+    }
+    cout << endl;
+    avl.remove(50);
+    cout << "Frozen copy keeps 50 after the tree drops it: should be 1: " << t.contains(50) << endl;
+    cout << endl;
+
+    // freezing a BinarySearchTree
+    BinarySearchTree<int> bst;
+    int values[] = {8, 3, 10, 1, 6, 14, 4, 7, 13};
+    for (int v : values) {
+        bst.insert(v);
+    }
+    FrozenTree<int> fb = bst.freeze();
+    cout << "Size: should be 9: " << fb.size() << endl;
+    cout << "Min: should be 1: " << fb.find_min() << endl;
+    cout << "Max: should be 14: " << fb.find_max() << endl;
+    cout << "Contains 13: should be 1: " << fb.contains(13) << endl;
+    cout << "lower_bound(11): should be 13: " << *fb.lower_bound(11) << endl;
+    cout << endl;
+
+    // straight from unsorted values with repeats
+    std::vector<int> unsorted = {5, 3, 9, 3, 1, 9};
+    FrozenTree<int> fu(unsorted.begin(), unsorted.end());
+    cout << "Size: should be 4: " << fu.size() << endl;
+    cout << "In order: should be 1 3 5 9: ";
+    for (int v : fu) {
+        cout << v << ' ';
+    }
+    cout << endl;
+    cout << endl;
+
+    // bigger tree against what it should hold
+    AVLTree<int> big;
+    for (int i = 0; i < 100000; i += 2) {
+        big.insert(i);
+    }
+    FrozenTree<int> fbig = big.freeze();
+    int wrong = 0;
+    for (int i = -1; i <= 100000; i++) {
+        wrong += fbig.contains(i) != (i >= 0 && i < 100000 && i % 2 == 0);
+        FrozenTree<int>::const_iterator lb = fbig.lower_bound(i);
+        int expected = (i <= 0) ? 0 : i + (i % 2);
+        wrong += (expected < 100000) ? (lb == fbig.end() || *lb != expected) : (lb != fbig.end());
+    }
+    cout << "Wrong answers over 50000 values: should be 0: " << wrong << endl;
+    cout << "Size: should be 50000: " << fbig.size() << endl;
+    cout << "Max: should be 99998: " << fbig.find_max() << endl;
+
+    // char tree
+    AVLTree<char> ct;
+    ct.insert('c');
+    ct.insert('a');
+    ct.insert('z');
+    ct.insert('b');
+    FrozenTree<char> fc = ct.freeze();
+    fc.print_tree();
+    cout << "Min val: should be a: " << fc.find_min() << endl;
+    cout << "Max val: should be z: " << fc.find_max() << endl;
+    cout << endl;
+
+    // frozen trees keep the comparator of the tree they came from
+    AVLTree<int, NodePool, std::greater<int>> down;
+    for (int i = 1; i <= 7; i++) {
+        down.insert(i);
+    }
+    FrozenTree<int, std::greater<int>> fd = down.freeze();
+    cout << "Greater first: should be 7 6 5 4 3 2 1: ";
+    for (int v : fd) {
+        cout << v << ' ';
+    }
+    cout << endl;
+    cout << "Contains 3: should be 1: " << fd.contains(3) << endl;
+    cout << "lower_bound(0) is end: should be 1: " << (fd.lower_bound(0) == fd.end()) << endl;
+    cout << "upper_bound(5): should be 4: " << *fd.upper_bound(5) << endl;
+    std::vector<int> repeated = {4, 9, 4, 1};
+    FrozenTree<int, std::greater<int>> fr(repeated.begin(), repeated.end());
+    cout << "Sorted by comparator: should be 9 4 1: ";
+    for (int v : fr) {
+        cout << v << ' ';
+    }
+    cout << endl;
+    return 0;
+}
@@ -0,0 +1,267 @@
+/*****************************************
+** File:    mapped_tree.h
+** Project: CSCE 221 Lab 4 Spring 2022
+** Author:  Naimur Rahman
+** Date:    03/21/2022
+** Section: 511
+** E-mail:  naimurrah01@tamu.edu
+** Description: Implementation for MappedTree class, a read-only tree searched straight from a saved tree file
+**/
+#ifndef MAPPED_TREE_H
+#define MAPPED_TREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "tree_file.h"
+#include "tree_print.h"
+using std::cout, std::endl;
+
+// A file written by AVLTree::save() or BinarySearchTree::save(), mapped into
+// memory read-only and searched where it lies. Opening one reads only the
+// header, so it takes the same time for any size of file, and the pages of
+// values are read in by the operating system as searches touch them. The
+// sorted values are searched as the balanced tree they would make, middle
+// value first, with a loop that has no branch to mispredict. Compare has to
+// be the order the file was saved in.
+template <typename Comparable, typename Compare = std::less<Comparable>>
+class MappedTree {
+private:
+    void* mapping = nullptr;           // whole file as mapped, nullptr if nothing is
+    std::size_t mappingSize = 0;       // bytes mapped
+    const Comparable* keys = nullptr;  // the values, just past the header
+    std::size_t count = 0;             // number of values
+    Compare comp;                      // order of the values
+
+    //-------------------------------------------------------
+    // Name: searchIndex(const Comparable& x)
+    // PreCondition:  Comparable x given, tree not empty
+    // PostCondition: returns the index of the first value not less than x, count if there is none
+    //---------------------------------------------------------
+    std::size_t searchIndex(const Comparable& x) const {
+        const Comparable* base = this->keys;
+        std::size_t n = this->count;
+        while (n > 1) {
+            std::size_t half = n / 2;
+            // the middle of either half is looked at next, so ask for both while this one is compared
+            __builtin_prefetch(base + half / 2);
+            __builtin_prefetch(base + half + half / 2);
+            base = this->comp(base[half], x) ? base + half : base;
+            n -= half;
+        }
+        return static_cast<std::size_t>(base - this->keys) + this->comp(*base, x);
+    }
+
+    //-------------------------------------------------------
+    // Name: unmap()
+    // PreCondition:  none
+    // PostCondition: unmaps the file, if one is mapped, and leaves the tree empty
+    //---------------------------------------------------------
+    void unmap() {
+        if (this->mapping != nullptr) {
+            munmap(this->mapping, this->mappingSize);
+        }
+        this->mapping = nullptr;
+        this->mappingSize = 0;
+        this->keys = nullptr;
+        this->count = 0;
+    }
+
+    //-------------------------------------------------------
+    // Name: printTreeLine(std::size_t lo, std::size_t hi, int space, TreeWriter& out)
+    // PreCondition:  values lo up to hi given with value for space, and the TreeWriter out collecting the text
+    // PostCondition: recursively prints the values as the balanced tree they are searched as, rotated 90 degrees
+    //---------------------------------------------------------
+    void printTreeLine(std::size_t lo, std::size_t hi, int space, TreeWriter& out) const {
+        if (lo >= hi) {
+            return;
+        }
+        std::size_t mid = lo + (hi - lo) / 2;
+        space++; // amount of levels
+        printTreeLine(mid + 1, hi, space, out);
+        out.indent(2 * (space - 1)).value(this->keys[mid]).endLine();
+        printTreeLine(lo, mid, space, out);
+    }
+
+public:
+    using const_iterator = const Comparable*;
+    using iterator = const_iterator;
+
+    //-------------------------------------------------------
+    // Name: MappedTree()
+    // PreCondition: none
+    // PostCondition: creates an empty MappedTree with no file mapped
+    //---------------------------------------------------------
+    MappedTree() = default;
+
+    //-------------------------------------------------------
+    // Name: MappedTree(const std::string& path, const Compare& comp = Compare())
+    // PreCondition: path of a tree file of Comparable values saved in the order of comp
+    // PostCondition: maps the file read-only, throwing std::runtime_error if it cannot be mapped or is
+    //                not a tree file of Comparable values. No values are read.
+    //---------------------------------------------------------
+    explicit MappedTree(const std::string& path, const Compare& comp = Compare()) : comp(comp) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("could not open tree file " + path);
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || static_cast<std::uint64_t>(info.st_size) < sizeof(TreeFileHeader)) {
+            close(fd);
+            throw std::runtime_error(path + " is not a tree file");
+        }
+        this->mappingSize = static_cast<std::size_t>(info.st_size);
+        void* p = mmap(nullptr, this->mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd); // the mapping keeps the file open
+        if (p == MAP_FAILED) {
+            throw std::runtime_error("could not map tree file " + path);
+        }
+        this->mapping = p;
+
+        const TreeFileHeader* header = static_cast<const TreeFileHeader*>(p);
+        try {
+            checkTreeFileHeader(*header, sizeof(Comparable), this->mappingSize, path);
+        }
+        catch (...) {
+            unmap();
+            throw;
+        }
+        this->keys = reinterpret_cast<const Comparable*>(header + 1);
+        this->count = static_cast<std::size_t>(header->count);
+    }
+
+    // a mapping has one owner, so the tree moves but does not copy
+    MappedTree(const MappedTree&) = delete;
+    MappedTree& operator=(const MappedTree&) = delete;
+
+    //-------------------------------------------------------
+    // Name: MappedTree(MappedTree&& other)
+    // PreCondition: MappedTree other passed as an rvalue
+    // PostCondition: takes over the mapping of other, leaving other empty
+    //---------------------------------------------------------
+    MappedTree(MappedTree&& other)
+        : mapping(other.mapping), mappingSize(other.mappingSize), keys(other.keys), count(other.count),
+          comp(other.comp) {
+        other.mapping = nullptr;
+        other.unmap();
+    }
+
+    //-------------------------------------------------------
+    // Name: operator=(MappedTree&& other)
+    // PreCondition: MappedTree other passed as an rvalue
+    // PostCondition: unmaps this tree's file and takes over the mapping of other, leaving other empty
+    //---------------------------------------------------------
+    MappedTree& operator=(MappedTree&& other) {
+        if (this != &other) { // if not same object
+            unmap();
+            std::swap(this->mapping, other.mapping);
+            std::swap(this->mappingSize, other.mappingSize);
+            std::swap(this->keys, other.keys);
+            std::swap(this->count, other.count);
+            this->comp = other.comp;
+        }
+        return *this;
+    }
+
+    //-------------------------------------------------------
+    // Name: ~MappedTree()
+    // PreCondition: MappedTree object has already been created
+    // PostCondition: unmaps the file
+    //---------------------------------------------------------
+    ~MappedTree() {
+        unmap();
+    }
+
+    //-------------------------------------------------------
+    // Name: contains(const Comparable& value)
+    // PreCondition: Comparable value passed by reference
+    // PostCondition: return true if value is in the file, false if not
+    //---------------------------------------------------------
+    bool contains(const Comparable& value) const {
+        if (is_empty()) {
+            return false;
+        }
+        std::size_t k = searchIndex(value);
+        return k != this->count && !this->comp(value, this->keys[k]);
+    }
+
+    //-------------------------------------------------------
+    // Name: lower_bound(const Comparable& value)
+    // PreCondition: Comparable value passed by reference
+    // PostCondition: returns an iterator to the first value not less than value, or end()
+    //---------------------------------------------------------
+    const_iterator lower_bound(const Comparable& value) const {
+        return is_empty() ? end() : this->keys + searchIndex(value);
+    }
+
+    //-------------------------------------------------------
+    // Name: find_min()
+    // PreCondition: tree is not empty
+    // PostCondition: returns the minimum value
+    //---------------------------------------------------------
+    const Comparable& find_min() const {
+        if (is_empty()) {
+            throw std::invalid_argument("MappedTree is empty");
+        }
+        return this->keys[0];
+    }
+
+    //-------------------------------------------------------
+    // Name: find_max()
+    // PreCondition: tree is not empty
+    // PostCondition: returns the maximum value
+    //---------------------------------------------------------
+    const Comparable& find_max() const {
+        if (is_empty()) {
+            throw std::invalid_argument("MappedTree is empty");
+        }
+        return this->keys[this->count - 1];
+    }
+
+    //-------------------------------------------------------
+    // Name: begin() / end()
+    // PreCondition: none
+    // PostCondition: iterators to the minimum value and one past the maximum, pointing into the mapping
+    //---------------------------------------------------------
+    const_iterator begin() const { return this->keys; }
+    const_iterator end() const { return this->keys + this->count; }
+
+    //-------------------------------------------------------
+    // Name: print_tree(std::ostream& os=std::cout)
+    // PreCondition: ostream os defaults to cout if none given
+    // PostCondition: prints 90 degree rotated tree to os
+    //---------------------------------------------------------
+    void print_tree(std::ostream& os=std::cout) const {
+        if (!is_empty()) {
+            TreeWriter out(os);
+            printTreeLine(0, this->count, 0, out);
+        }
+        else { // empty tree
+            os << "<empty>\n";
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: is_empty()
+    // PreCondition: none
+    // PostCondition: returns true if tree is empty, false if it isnt
+    //---------------------------------------------------------
+    bool is_empty() const { return this->count == 0; }
+
+    //-------------------------------------------------------
+    // Name: size()
+    // PreCondition: none
+    // PostCondition: returns the number of values in the file
+    //---------------------------------------------------------
+    std::size_t size() const { return this->count; }
+};
+
+#endif
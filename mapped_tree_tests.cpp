@@ -0,0 +1,137 @@
+/*****************************************
+** File:    mapped_tree_tests.cpp
+** Project: CSCE 221 Lab 4 Spring 2022
+** Author:  Naimur Rahman
+** Date:    03/21/2022
+** Section: 511
+** E-mail:  naimurrah01@tamu.edu
+** Description: Tests for MappedTree Class and the tree file format
+**/
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <utility>
+#include "avl_tree.h"
+#include "binary_search_tree.h"
+#include "mapped_tree.h"
+
+using std::cout, std::endl;
+
+int main() {
+    MappedTree<int> empty;
+
+    // fail min/max test:
+    try {
+        empty.find_min();
+    }
+    catch (const std::invalid_argument&) {
+        cout << "Invalid min test success" << endl;
+    }
+    try {
+        empty.find_max();
+    }
+    catch (const std::invalid_argument&) {
+        cout << "Invalid max test success" << endl;
+    }
+    cout << "printing empty tree: " << endl;
+    empty.print_tree();
+    cout << "Empty? should be 1: " << empty.is_empty() << endl;
+    cout << "Contains 1: should be 0: " << empty.contains(1) << endl;
+    cout << "begin is end: should be 1: " << (empty.begin() == empty.end()) << endl;
+    cout << endl;
+
+    // mapping a saved AVLTree
+    AVLTree<int> avl;
+    for (int i = 1; i <= 10; i++) {
+        avl.insert(i * 10);
+    }
+    avl.save("mapped_tree_tests.tree");
+    MappedTree<int> t("mapped_tree_tests.tree");
+    t.print_tree();
+    cout << "Size: should be 10: " << t.size() << endl;
+    cout << "Min: should be 10: " << t.find_min() << endl;
+    cout << "Max: should be 100: " << t.find_max() << endl;
+    cout << "Contains 50: should be 1: " << t.contains(50) << endl;
+    cout << "Contains 55: should be 0: " << t.contains(55) << endl;
+    cout << "Contains 5: should be 0: " << t.contains(5) << endl;
+    cout << "Contains 105: should be 0: " << t.contains(105) << endl;
+    cout << "lower_bound(55): should be 60: " << *t.lower_bound(55) << endl;
+    cout << "lower_bound(101) is end: should be 1: " << (t.lower_bound(101) == t.end()) << endl;
+    cout << "In order: should be 10 20 30 40 50 60 70 80 90 100: ";
+    for (int v : t) {
+        cout << v << ' ';
+    }
+    cout << endl;
+    cout << endl;
+
+    // moving keeps the mapping, and the file can be replaced while it is mapped
+    MappedTree<int> moved(std::move(t));
+    cout << "Moved from is empty: should be 1: " << t.is_empty() << endl;
+    avl.make_empty();
+    avl.insert(7);
+    avl.save("mapped_tree_tests.tree");
+    cout << "Mapped before save, max: should be 100: " << moved.find_max() << endl;
+    t = MappedTree<int>("mapped_tree_tests.tree");
+    cout << "Mapped after save, max: should be 7: " << t.find_max() << endl;
+    cout << endl;
+
+    // a big BinarySearchTree file, every value looked up
+    BinarySearchTree<long long> bst;
+    for (long long i = 0; i < 100000; i++) {
+        bst.insert((i * 7919) % 100000 * 3);
+    }
+    bst.save("mapped_tree_tests.tree");
+    MappedTree<long long> big("mapped_tree_tests.tree");
+    int wrong = 0;
+    for (long long i = -1; i < 300002; i++) {
+        wrong += (big.contains(i) != (i >= 0 && i % 3 == 0 && i < 300000));
+    }
+    cout << "Wrong answers from 300003 lookups: should be 0: " << wrong << endl;
+    cout << "Size: should be 100000: " << big.size() << endl;
+    cout << "Max: should be 299997: " << big.find_max() << endl;
+    cout << endl;
+
+    // comparators
+    AVLTree<int, NodePool, std::greater<int>> down;
+    for (int i = 1; i <= 6; i++) {
+        down.insert(i);
+    }
+    down.save("mapped_tree_tests.tree");
+    MappedTree<int, std::greater<int>> mappedDown("mapped_tree_tests.tree");
+    cout << "Greater min: should be 6: " << mappedDown.find_min() << endl;
+    cout << "Contains 4: should be 1: " << mappedDown.contains(4) << endl;
+    cout << "Contains 0: should be 0: " << mappedDown.contains(0) << endl;
+    cout << endl;
+
+    // files that cannot be mapped
+    try {
+        MappedTree<int> missing("no_such_file.tree");
+    }
+    catch (const std::runtime_error&) {
+        cout << "Missing file test success" << endl;
+    }
+    try {
+        MappedTree<short> wrongType("mapped_tree_tests.tree");
+    }
+    catch (const std::runtime_error&) {
+        cout << "Wrong value size test success" << endl;
+    }
+    std::ofstream("mapped_tree_tests.tree", std::ios::binary) << "not a tree file, but longer than a header";
+    try {
+        MappedTree<int> notTree("mapped_tree_tests.tree");
+    }
+    catch (const std::runtime_error&) {
+        cout << "Not a tree file test success" << endl;
+    }
+    down.save("mapped_tree_tests.tree");
+    std::ofstream("mapped_tree_tests.tree", std::ios::binary | std::ios::app) << 'x';
+    try {
+        MappedTree<int> extra("mapped_tree_tests.tree");
+    }
+    catch (const std::runtime_error&) {
+        cout << "Extra bytes test success" << endl;
+    }
+    std::remove("mapped_tree_tests.tree");
+    return 0;
+}
@@ -0,0 +1,201 @@
+/*****************************************
+** File:    node_pool.h
+** Project: CSCE 221 Lab 4 Spring 2022
+** Author:  Naimur Rahman
+** Date:    03/21/2022
+** Section: 511
+** E-mail:  naimurrah01@tamu.edu
+** Description: Node allocator policies for BinarySearchTree and AVLTree
+**/
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// A node allocator policy hands out raw, uninitialized storage for one Node at a
+// time; the tree constructs and destroys the Node itself. RELEASES_ALL tells the
+// tree whether release() gives back the storage of every node still allocated,
+// so it can skip freeing nodes one at a time when emptying itself. share() and
+// adopt() let nodes move from one tree to another, for split() and the set
+// operations: after either call every node of the other pool may be freed through
+// this one. Shared arenas are only kept alive, never carved from, so two trees
+// that split one tree between them can each insert on their own thread.
+
+template <typename Node>
+class NodePool {
+private:
+    static const std::size_t FIRST_SLAB = 64;     // nodes in the first slab
+    static const std::size_t MAX_SLAB = 65536;    // slabs stop doubling at this many nodes
+
+    // storage for one node, reused as a free list link once the node is freed
+    union Slot {
+        Slot* next;
+        alignas(Node) unsigned char storage[sizeof(Node)];
+    };
+
+    // slabs nodes are carved from, shared by the pools of trees that split one tree between them
+    struct Arena {
+        std::vector<std::unique_ptr<Slot[]>> slabs; // every slab handed out so far
+        Slot* next = nullptr;                        // next never used slot in the newest slab
+        Slot* end = nullptr;                         // one past the newest slab
+        std::size_t slabSize = FIRST_SLAB;           // size of the next slab to allocate
+    };
+
+    std::vector<std::shared_ptr<Arena>> arenas; // every arena the nodes of this pool can be in
+    Arena* current = nullptr;                    // arena new nodes are carved from, never one another pool carves from
+    Slot* freeList = nullptr;                    // nodes given back through deallocate()
+    Slot* freeTail = nullptr;                    // last node on the free list, for adopt()
+
+    //-------------------------------------------------------
+    // Name: grow()
+    // PreCondition:  newest slab of the current arena has been used up
+    // PostCondition: allocates a new slab, doubling its size up to MAX_SLAB nodes
+    //---------------------------------------------------------
+    void grow() {
+        if (this->current == nullptr) { // first node of the pool
+            this->arenas.push_back(std::make_shared<Arena>());
+            this->current = this->arenas.back().get();
+        }
+        Arena& a = *this->current;
+        a.slabs.emplace_back(new Slot[a.slabSize]);
+        a.next = a.slabs.back().get();
+        a.end = a.next + a.slabSize;
+        if (a.slabSize < MAX_SLAB) {
+            a.slabSize *= 2;
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: addArenas(const NodePool& other)
+    // PreCondition:  other given
+    // PostCondition: holds on to every arena of other this pool does not have yet, without carving from them
+    //---------------------------------------------------------
+    void addArenas(const NodePool& other) {
+        for (const std::shared_ptr<Arena>& a : other.arenas) {
+            if (std::find(this->arenas.begin(), this->arenas.end(), a) == this->arenas.end()) {
+                this->arenas.push_back(a);
+            }
+        }
+    }
+
+public:
+    static const bool RELEASES_ALL = true;
+
+    NodePool() = default;
+
+    // a pool owns the storage of one tree, copies start with none of it
+    NodePool(const NodePool&) {}
+    NodePool& operator=(const NodePool&) { return *this; }
+
+    //-------------------------------------------------------
+    // Name: allocate()
+    // PreCondition:  none
+    // PostCondition: returns uninitialized storage for one Node, reusing freed nodes first
+    //---------------------------------------------------------
+    Node* allocate() {
+        Slot* s;
+        if (this->freeList != nullptr) { // recycle a freed node
+            s = this->freeList;
+            this->freeList = s->next;
+        }
+        else { // bump the pointer, adding a slab when needed
+            if (this->current == nullptr || this->current->next == this->current->end) {
+                grow();
+            }
+            s = this->current->next++;
+        }
+        return reinterpret_cast<Node*>(s->storage);
+    }
+
+    //-------------------------------------------------------
+    // Name: deallocate(Node* p)
+    // PreCondition:  p came from allocate() of this pool, or of a pool it shares or adopted, and has been destroyed
+    // PostCondition: puts the storage of p on the free list for the next allocate()
+    //---------------------------------------------------------
+    void deallocate(Node* p) {
+        Slot* s = reinterpret_cast<Slot*>(p);
+        if (this->freeList == nullptr) {
+            this->freeTail = s;
+        }
+        s->next = this->freeList;
+        this->freeList = s;
+    }
+
+    //-------------------------------------------------------
+    // Name: release()
+    // PreCondition:  every node allocated from the pool has been destroyed
+    // PostCondition: lets go of every arena, freeing whole slabs instead of single nodes once no other pool shares them
+    //---------------------------------------------------------
+    void release() {
+        this->arenas.clear();
+        this->current = nullptr;
+        this->freeList = nullptr;
+        this->freeTail = nullptr;
+    }
+
+    //-------------------------------------------------------
+    // Name: share(NodePool& other)
+    // PreCondition:  other given
+    // PostCondition: this pool keeps the arenas of other alive too, so nodes of other can be handed to this pool's
+    //                tree. New nodes of this pool still come from an arena of its own.
+    //---------------------------------------------------------
+    void share(NodePool& other) {
+        addArenas(other);
+    }
+
+    //-------------------------------------------------------
+    // Name: adopt(NodePool& other)
+    // PreCondition:  other given
+    // PostCondition: takes over the arenas and free nodes of other, leaving other empty
+    //---------------------------------------------------------
+    void adopt(NodePool& other) {
+        if (&other == this) {
+            return;
+        }
+        addArenas(other);
+        if (this->current == nullptr) { // other stops carving from its arena, so this pool can
+            this->current = other.current;
+        }
+        if (other.freeList != nullptr) { // splice the free lists
+            other.freeTail->next = this->freeList;
+            if (this->freeList == nullptr) {
+                this->freeTail = other.freeTail;
+            }
+            this->freeList = other.freeList;
+        }
+        other.release();
+    }
+
+    //-------------------------------------------------------
+    // Name: swap(NodePool& other)
+    // PreCondition:  other given
+    // PostCondition: exchanges the storage of this pool and other
+    //---------------------------------------------------------
+    void swap(NodePool& other) noexcept {
+        std::swap(this->arenas, other.arenas);
+        std::swap(this->current, other.current);
+        std::swap(this->freeList, other.freeList);
+        std::swap(this->freeTail, other.freeTail);
+    }
+};
+
+// allocates every node on its own with operator new, as the trees used to
+template <typename Node>
+class HeapAllocator {
+public:
+    static const bool RELEASES_ALL = false;
+
+    Node* allocate() { return static_cast<Node*>(::operator new(sizeof(Node), std::align_val_t(alignof(Node)))); }
+    void deallocate(Node* p) { ::operator delete(p, std::align_val_t(alignof(Node))); }
+    void release() {}
+    void share(HeapAllocator&) {}
+    void adopt(HeapAllocator&) {}
+    void swap(HeapAllocator&) noexcept {}
+};
+
+#endif
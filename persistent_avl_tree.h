@@ -0,0 +1,633 @@
+/*****************************************
+** File:    persistent_avl_tree.h
+** Project: CSCE 221 Lab 4 Spring 2022
+** Author:  Naimur Rahman
+** Date:    03/21/2022
+** Section: 511
+** E-mail:  naimurrah01@tamu.edu
+** Description: Implementation for PersistentAVLTree class, an AVL tree many threads can read while one writes
+**/
+#ifndef PERSISTENT_AVL_TREE_H
+#define PERSISTENT_AVL_TREE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "tree_print.h"
+using std::cout, std::endl;
+
+// Same set of operations as AVLTree, but nodes are never changed once they are
+// linked in. insert() and remove() copy the path from the root down to the
+// change, rotations included, and share every other subtree with the old
+// version; the new root is then published with one atomic store. Readers never
+// take a lock and always see a whole version of the tree. Each node counts the
+// parents and roots pointing at it. Old roots are set aside and freed in
+// batches, once the last reader that could still be walking them has left, so
+// writers wait on readers once per batch rather than on every write.
+// snapshot() holds on to a
+// version in O(1) the same way, for as long as the caller wants to read it.
+template <typename Comparable>
+class PersistentAVLTree {
+private:
+    static const std::size_t READER_STRIPES = 16; // reader counters, spread so readers rarely share a cache line
+    static const std::size_t RECLAIM_BATCH = 1024; // old roots gathered before waiting out readers to free them
+
+    // struct for nodes of the tree, fixed once linked in apart from refs
+    struct persistentNode {
+        Comparable data;
+        const persistentNode* left;
+        const persistentNode* right;
+        int height;
+        std::size_t size; // values in the subtree, so every version knows its own size
+        mutable std::atomic<std::size_t> refs; // parents, roots and snapshots pointing here
+    };
+
+    // readers inside a read section, split by the parity of the epoch they entered under
+    struct alignas(64) ReaderCount {
+        std::atomic<long> active[2] = {{0}, {0}};
+    };
+
+    std::atomic<const persistentNode*> root{nullptr}; // newest version
+    std::mutex writer;                                  // one insert or remove at a time
+    std::atomic<unsigned> epoch{0};                     // flipped by writers waiting out old readers
+    mutable ReaderCount readers[READER_STRIPES];
+    std::vector<const persistentNode*> retired;         // old roots readers may still be walking, guarded by writer
+
+    // node helpers - every function taking or returning a node pointer passes one reference along with it
+
+    //-------------------------------------------------------
+    // Name: makeNode(const Comparable& data, const persistentNode* l, const persistentNode* r)
+    // PreCondition:  value data and references to subtrees l and r, with values less and greater than data
+    // PostCondition: returns a reference to a new node holding data over l and r
+    //---------------------------------------------------------
+    static const persistentNode* makeNode(const Comparable& data, const persistentNode* l, const persistentNode* r) {
+        return new persistentNode{data, l, r, std::max(height(l), height(r)) + 1, sizeOf(l) + sizeOf(r) + 1, {1}};
+    }
+
+    //-------------------------------------------------------
+    // Name: retain(const persistentNode* t)
+    // PreCondition:  node t given, can be nullptr
+    // PostCondition: adds a reference to t and returns it
+    //---------------------------------------------------------
+    static const persistentNode* retain(const persistentNode* t) {
+        if (t != nullptr) {
+            t->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+        return t;
+    }
+
+    //-------------------------------------------------------
+    // Name: release(const persistentNode* t)
+    // PreCondition:  a reference to node t, can be nullptr
+    // PostCondition: drops the reference, freeing t and releasing its children if it was the last one
+    //---------------------------------------------------------
+    static void release(const persistentNode* t) {
+        while (t != nullptr && t->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            const persistentNode* right = t->right;
+            release(t->left);
+            delete t;
+            t = right; // right side without recursing
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: height(const persistentNode* t)
+    // PreCondition:  node t given
+    // PostCondition: returns int height of node t, -1 for nullptr
+    //---------------------------------------------------------
+    static int height(const persistentNode* t) {
+        return (t == nullptr) ? -1 : t->height;
+    }
+
+    //-------------------------------------------------------
+    // Name: sizeOf(const persistentNode* t)
+    // PreCondition:  node t given
+    // PostCondition: returns number of values in subtree t, 0 for nullptr
+    //---------------------------------------------------------
+    static std::size_t sizeOf(const persistentNode* t) {
+        return (t == nullptr) ? 0 : t->size;
+    }
+
+    //-------------------------------------------------------
+    // Name: balanced(const Comparable& data, const persistentNode* l, const persistentNode* r)
+    // PreCondition:  same as makeNode(), l and r at most two levels apart in height
+    // PostCondition: returns a reference to a balanced subtree holding l, data and r, rotating by building
+    //                new nodes instead of changing the ones l and r share with older versions
+    //---------------------------------------------------------
+    static const persistentNode* balanced(const Comparable& data, const persistentNode* l, const persistentNode* r) {
+        const persistentNode* t;
+        if (height(l) - height(r) > 1) { // left side too tall
+            if (height(l->left) >= height(l->right)) { // single rotation
+                t = makeNode(l->data, retain(l->left), makeNode(data, retain(l->right), r));
+            }
+            else { // double rotation
+                const persistentNode* lr = l->right;
+                t = makeNode(lr->data, makeNode(l->data, retain(l->left), retain(lr->left)),
+                             makeNode(data, retain(lr->right), r));
+            }
+            release(l);
+        }
+        else if (height(r) - height(l) > 1) { // right side too tall
+            if (height(r->right) >= height(r->left)) { // single rotation
+                t = makeNode(r->data, makeNode(data, l, retain(r->left)), retain(r->right));
+            }
+            else { // double rotation
+                const persistentNode* rl = r->left;
+                t = makeNode(rl->data, makeNode(data, l, retain(rl->left)),
+                             makeNode(r->data, retain(rl->right), retain(r->right)));
+            }
+            release(r);
+        }
+        else {
+            t = makeNode(data, l, r);
+        }
+        return t;
+    }
+
+    //-------------------------------------------------------
+    // Name: insertPath(const persistentNode* t, const Comparable& x)
+    // PreCondition:  tree t, which is not changed, and Comparable x given
+    // PostCondition: returns a reference to a new version of t holding x, sharing every subtree off the path to x,
+    //                or nullptr if x is already in t
+    //---------------------------------------------------------
+    static const persistentNode* insertPath(const persistentNode* t, const Comparable& x) {
+        if (t == nullptr) {
+            return makeNode(x, nullptr, nullptr);
+        }
+        if (x < t->data) {
+            const persistentNode* l = insertPath(t->left, x);
+            return (l == nullptr) ? nullptr : balanced(t->data, l, retain(t->right));
+        }
+        if (t->data < x) {
+            const persistentNode* r = insertPath(t->right, x);
+            return (r == nullptr) ? nullptr : balanced(t->data, retain(t->left), r);
+        }
+        return nullptr; // already in tree
+    }
+
+    //-------------------------------------------------------
+    // Name: removeMinPath(const persistentNode* t, const persistentNode*& min)
+    // PreCondition:  tree t that is not empty
+    // PostCondition: sets min to the node holding the minimum and returns a reference to a new version of t without it
+    //---------------------------------------------------------
+    static const persistentNode* removeMinPath(const persistentNode* t, const persistentNode*& min) {
+        if (t->left == nullptr) {
+            min = t;
+            return retain(t->right);
+        }
+        return balanced(t->data, removeMinPath(t->left, min), retain(t->right));
+    }
+
+    //-------------------------------------------------------
+    // Name: removePath(const persistentNode* t, const Comparable& x, bool& removed)
+    // PreCondition:  tree t, which is not changed, and Comparable x given
+    // PostCondition: returns a reference to a new version of t without x and sets removed,
+    //                or returns nullptr with removed false if x is not in t
+    //---------------------------------------------------------
+    static const persistentNode* removePath(const persistentNode* t, const Comparable& x, bool& removed) {
+        removed = false;
+        if (t == nullptr) { // not in tree
+            return nullptr;
+        }
+        if (x < t->data) {
+            const persistentNode* l = removePath(t->left, x, removed);
+            return removed ? balanced(t->data, l, retain(t->right)) : nullptr;
+        }
+        if (t->data < x) {
+            const persistentNode* r = removePath(t->right, x, removed);
+            return removed ? balanced(t->data, retain(t->left), r) : nullptr;
+        }
+        removed = true;
+        if (t->left == nullptr || t->right == nullptr) { // at most one child, which moves up
+            return retain((t->left != nullptr) ? t->left : t->right);
+        }
+        const persistentNode* min; // successor takes t's place
+        const persistentNode* r = removeMinPath(t->right, min);
+        return balanced(min->data, retain(t->left), r);
+    }
+
+    // read helpers, shared by the tree and its snapshots
+
+    //-------------------------------------------------------
+    // Name: containsIn(const persistentNode* t, const Comparable& value)
+    // PreCondition:  tree t that can't be freed during the call, Comparable value given
+    // PostCondition: returns true if value is in t, false if not
+    //---------------------------------------------------------
+    static bool containsIn(const persistentNode* t, const Comparable& value) {
+        while (t != nullptr) {
+            if (value < t->data) { // shift left
+                t = t->left;
+            }
+            else if (t->data < value) { // shift right
+                t = t->right;
+            }
+            else { // value in tree
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //-------------------------------------------------------
+    // Name: endOf(const persistentNode* t, bool last)
+    // PreCondition:  tree t that can't be freed during the call
+    // PostCondition: returns the minimum value of t, or the maximum if last is true, throws invalid_argument if t is empty
+    //---------------------------------------------------------
+    static const Comparable& endOf(const persistentNode* t, bool last) {
+        if (t == nullptr) {
+            throw std::invalid_argument("Tree is Empty");
+        }
+        for (const persistentNode* next = last ? t->right : t->left; next != nullptr; next = last ? t->right : t->left) {
+            t = next;
+        }
+        return t->data;
+    }
+
+    // read section helpers
+
+    //-------------------------------------------------------
+    // Name: stripe()
+    // PreCondition:  none
+    // PostCondition: returns the reader counter this thread uses
+    //---------------------------------------------------------
+    static std::size_t stripe() {
+        static thread_local const std::size_t mine = std::hash<std::thread::id>()(std::this_thread::get_id()) % READER_STRIPES;
+        return mine;
+    }
+
+    // marks the calling thread as reading for as long as it lives
+    class ReadGuard {
+    private:
+        std::atomic<long>& active;
+
+    public:
+        explicit ReadGuard(const PersistentAVLTree& tree)
+            : active(tree.readers[stripe()].active[tree.epoch.load() & 1]) {
+            this->active.fetch_add(1);
+        }
+        ~ReadGuard() { this->active.fetch_sub(1, std::memory_order_release); }
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+    };
+
+    //-------------------------------------------------------
+    // Name: waitForReaders()
+    // PreCondition:  writer lock held, new root already published
+    // PostCondition: returns once every reader that could have loaded an older root has left. The epoch is
+    //                flipped twice, as a reader can read the epoch before one flip and count itself after it.
+    //---------------------------------------------------------
+    void waitForReaders() {
+        for (int phase = 0; phase < 2; phase++) {
+            unsigned old = this->epoch.fetch_add(1) & 1;
+            for (ReaderCount& r : this->readers) {
+                while (r.active[old].load(std::memory_order_acquire) != 0) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: reclaim()
+    // PreCondition:  writer lock held
+    // PostCondition: waits out every reader that could see a retired root, then frees what only they used
+    //---------------------------------------------------------
+    void reclaim() {
+        waitForReaders();
+        for (const persistentNode* old : this->retired) {
+            release(old);
+        }
+        this->retired.clear();
+    }
+
+    //-------------------------------------------------------
+    // Name: publish(const persistentNode* newRoot)
+    // PreCondition:  writer lock held, a reference to the next version newRoot
+    // PostCondition: makes newRoot the version readers see and retires the old one, reclaiming every
+    //                retired version once RECLAIM_BATCH of them have gathered
+    //---------------------------------------------------------
+    void publish(const persistentNode* newRoot) {
+        this->retired.push_back(this->root.exchange(newRoot));
+        if (this->retired.size() >= RECLAIM_BATCH) {
+            reclaim();
+        }
+    }
+
+public:
+    //-------------------------------------------------------
+    // Name: Snapshot
+    // Description: one version of the tree, kept alive for as long as the snapshot is. Nothing can change
+    //              it, so any number of threads can read it with no guard at all. Copying shares the version.
+    //---------------------------------------------------------
+    class Snapshot {
+    private:
+        const persistentNode* root; // one reference held
+
+        explicit Snapshot(const persistentNode* root) : root(root) {}
+        friend class PersistentAVLTree;
+
+    public:
+        //-------------------------------------------------------
+        // Name: const_iterator
+        // Description: forward in-order iterator over the values of a snapshot. Nodes have no parent
+        //              pointers, so it keeps the path from the root, at most the height of the tree.
+        //---------------------------------------------------------
+        class const_iterator {
+        private:
+            std::vector<const persistentNode*> path; // ancestors still to visit, current node on top
+
+            explicit const_iterator(const persistentNode* t) { descend(t); }
+            friend class Snapshot;
+
+            void descend(const persistentNode* t) {
+                for (; t != nullptr; t = t->left) { // go as far left as possible
+                    this->path.push_back(t);
+                }
+            }
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Comparable;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Comparable*;
+            using reference = const Comparable&;
+
+            const_iterator() = default;
+
+            reference operator*() const { return this->path.back()->data; }
+            pointer operator->() const { return &this->path.back()->data; }
+
+            const_iterator& operator++() {
+                const persistentNode* right = this->path.back()->right;
+                this->path.pop_back();
+                descend(right);
+                return *this;
+            }
+
+            const_iterator operator++(int) {
+                const_iterator old = *this;
+                ++(*this);
+                return old;
+            }
+
+            bool operator==(const const_iterator& rhs) const {
+                return (this->path.empty() || rhs.path.empty()) ? this->path.empty() == rhs.path.empty()
+                                                                 : this->path.back() == rhs.path.back();
+            }
+            bool operator!=(const const_iterator& rhs) const { return !(*this == rhs); }
+        };
+
+        using iterator = const_iterator;
+
+        //-------------------------------------------------------
+        // Name: Snapshot()
+        // PreCondition: none
+        // PostCondition: creates a snapshot of an empty tree
+        //---------------------------------------------------------
+        Snapshot() : root(nullptr) {}
+
+        //-------------------------------------------------------
+        // Name: Snapshot(const Snapshot& other)
+        // PreCondition: snapshot other given
+        // PostCondition: shares other's version in O(1)
+        //---------------------------------------------------------
+        Snapshot(const Snapshot& other) : root(retain(other.root)) {}
+
+        //-------------------------------------------------------
+        // Name: Snapshot(Snapshot&& other)
+        // PreCondition: snapshot other given
+        // PostCondition: takes other's version, leaving other empty
+        //---------------------------------------------------------
+        Snapshot(Snapshot&& other) noexcept : root(other.root) {
+            other.root = nullptr;
+        }
+
+        //-------------------------------------------------------
+        // Name: operator=(Snapshot other)
+        // PreCondition: snapshot other given, copied or moved in
+        // PostCondition: drops this version and holds other's instead
+        //---------------------------------------------------------
+        Snapshot& operator=(Snapshot other) noexcept {
+            std::swap(this->root, other.root);
+            return *this;
+        }
+
+        //-------------------------------------------------------
+        // Name: ~Snapshot()
+        // PreCondition: none
+        // PostCondition: drops the version, freeing the nodes no other version or snapshot shares
+        //---------------------------------------------------------
+        ~Snapshot() {
+            release(this->root);
+        }
+
+        //-------------------------------------------------------
+        // Name: contains(const Comparable& value)
+        // PreCondition: Comparable value passed by reference
+        // PostCondition: return true if value was in the tree when the snapshot was taken, false if not
+        //---------------------------------------------------------
+        bool contains(const Comparable& value) const { return containsIn(this->root, value); }
+
+        //-------------------------------------------------------
+        // Name: find_min()
+        // PreCondition: snapshot is not of an empty tree
+        // PostCondition: returns the minimum value
+        //---------------------------------------------------------
+        const Comparable& find_min() const { return endOf(this->root, false); }
+
+        //-------------------------------------------------------
+        // Name: find_max()
+        // PreCondition: snapshot is not of an empty tree
+        // PostCondition: returns the maximum value
+        //---------------------------------------------------------
+        const Comparable& find_max() const { return endOf(this->root, true); }
+
+        //-------------------------------------------------------
+        // Name: is_empty()
+        // PreCondition: none
+        // PostCondition: returns true if the snapshot is of an empty tree
+        //---------------------------------------------------------
+        bool is_empty() const { return this->root == nullptr; }
+
+        //-------------------------------------------------------
+        // Name: size()
+        // PreCondition: none
+        // PostCondition: returns the number of values in the snapshot
+        //---------------------------------------------------------
+        std::size_t size() const { return sizeOf(this->root); }
+
+        //-------------------------------------------------------
+        // Name: begin() / end()
+        // PreCondition: none
+        // PostCondition: iterators to the minimum value and past the maximum
+        //---------------------------------------------------------
+        const_iterator begin() const { return const_iterator(this->root); }
+        const_iterator end() const { return const_iterator(); }
+
+        //-------------------------------------------------------
+        // Name: print_tree(std::ostream& os=std::cout)
+        // PreCondition: ostream os defaults to cout if none given
+        // PostCondition: prints 90 degree rotated tree to os
+        //---------------------------------------------------------
+        void print_tree(std::ostream& os=std::cout) const {
+            if (this->root != nullptr) {
+                write_tree(os, this->root, TreeFormat::Rotated, NO_DEPTH_LIMIT);
+            }
+            else { // empty tree
+                os << "<empty>\n";
+            }
+        }
+    };
+
+    //-------------------------------------------------------
+    // Name: PersistentAVLTree()
+    // PreCondition: none
+    // PostCondition: creates new empty PersistentAVLTree object
+    //---------------------------------------------------------
+    PersistentAVLTree() = default;
+
+    // readers hold on to the tree itself, so it can't be copied or moved
+    PersistentAVLTree(const PersistentAVLTree&) = delete;
+    PersistentAVLTree& operator=(const PersistentAVLTree&) = delete;
+
+    //-------------------------------------------------------
+    // Name: ~PersistentAVLTree()
+    // PreCondition: no other thread is using the tree
+    // PostCondition: frees every node
+    //---------------------------------------------------------
+    ~PersistentAVLTree() {
+        for (const persistentNode* old : this->retired) {
+            release(old);
+        }
+        release(this->root.load());
+    }
+
+    //-------------------------------------------------------
+    // Name: contains(const Comparable& value)
+    // PreCondition: Comparable value passed by reference
+    // PostCondition: return true if value is in the newest version of the tree, false if not. Never blocks.
+    //---------------------------------------------------------
+    bool contains(const Comparable& value) const {
+        ReadGuard guard(*this);
+        return containsIn(this->root.load(), value);
+    }
+
+    //-------------------------------------------------------
+    // Name: insert(const Comparable& value)
+    // PreCondition: Comparable value passed by reference, writers from several threads take turns
+    // PostCondition: publishes a version of the tree with value and returns true, or returns false if it was there
+    //---------------------------------------------------------
+    bool insert(const Comparable& value) {
+        std::lock_guard<std::mutex> lock(this->writer);
+        const persistentNode* newRoot = insertPath(this->root.load(), value);
+        if (newRoot == nullptr) { // already in tree
+            return false;
+        }
+        publish(newRoot);
+        return true;
+    }
+
+    //-------------------------------------------------------
+    // Name: remove(const Comparable& value)
+    // PreCondition: Comparable value passed by reference
+    // PostCondition: publishes a version of the tree without value and returns true, or returns false if it was not there
+    //---------------------------------------------------------
+    bool remove(const Comparable& value) {
+        std::lock_guard<std::mutex> lock(this->writer);
+        bool removed;
+        const persistentNode* newRoot = removePath(this->root.load(), value, removed);
+        if (!removed) {
+            return false;
+        }
+        publish(newRoot);
+        return true;
+    }
+
+    //-------------------------------------------------------
+    // Name: find_min()
+    // PreCondition: root is not a nullptr
+    // PostCondition: returns a copy of the minimum value, as the node holding it may be freed once the read is over
+    //---------------------------------------------------------
+    Comparable find_min() const {
+        ReadGuard guard(*this);
+        return endOf(this->root.load(), false);
+    }
+
+    //-------------------------------------------------------
+    // Name: find_max()
+    // PreCondition: root is not a nullptr
+    // PostCondition: returns a copy of the maximum value
+    //---------------------------------------------------------
+    Comparable find_max() const {
+        ReadGuard guard(*this);
+        return endOf(this->root.load(), true);
+    }
+
+    //-------------------------------------------------------
+    // Name: print_tree(std::ostream& os=std::cout)
+    // PreCondition: ostream os defaults to cout if none given
+    // PostCondition: prints 90 degree rotated tree to os, all from one version
+    //---------------------------------------------------------
+    void print_tree(std::ostream& os=std::cout) const {
+        ReadGuard guard(*this);
+        const persistentNode* current = this->root.load();
+        if (current != nullptr) {
+            write_tree(os, current, TreeFormat::Rotated, NO_DEPTH_LIMIT);
+        }
+        else { // empty tree
+            os << "<empty>\n";
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: is_empty()
+    // PreCondition: none
+    // PostCondition: returns true if tree is empty, false if it isnt
+    //---------------------------------------------------------
+    bool is_empty() const {
+        return this->root.load() == nullptr;
+    }
+
+    //-------------------------------------------------------
+    // Name: size()
+    // PreCondition: none
+    // PostCondition: returns the number of values in the newest version
+    //---------------------------------------------------------
+    std::size_t size() const {
+        ReadGuard guard(*this);
+        return sizeOf(this->root.load());
+    }
+
+    //-------------------------------------------------------
+    // Name: make_empty()
+    // PreCondition: none
+    // PostCondition: publishes an empty version of the tree and frees every node no reader still needs
+    //---------------------------------------------------------
+    void make_empty() {
+        std::lock_guard<std::mutex> lock(this->writer);
+        publish(nullptr);
+        reclaim();
+    }
+
+    //-------------------------------------------------------
+    // Name: snapshot()
+    // PreCondition: none
+    // PostCondition: returns a read-only view of the newest version in O(1). Later writes copy the paths they
+    //                change instead of touching the snapshot's nodes, which are freed once the snapshot and
+    //                every version sharing them are gone.
+    //---------------------------------------------------------
+    Snapshot snapshot() const {
+        ReadGuard guard(*this); // keeps the root alive until it is retained
+        return Snapshot(retain(this->root.load()));
+    }
+};
+
+#endif
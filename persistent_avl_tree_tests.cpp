@@ -0,0 +1,191 @@
+/*****************************************
+** File:    persistent_avl_tree_tests.cpp
+** Project: CSCE 221 Lab 4 Spring 2022
+** Author:  Naimur Rahman
+** Date:    03/21/2022
+** Section: 511
+** E-mail:  naimurrah01@tamu.edu
+** Description: Tests for PersistentAVLTree Class
+**/
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "persistent_avl_tree.h"
+
+using std::cout, std::endl;
+
+int main() {
+    PersistentAVLTree<int> t;
+
+    // fail min/max test:
+    try {
+        t.find_min();
+    }
+    catch (const std::invalid_argument&) {
+        cout << "Invalid min test success" << endl;
+    }
+    try {
+        t.find_max();
+    }
+    catch (const std::invalid_argument&) {
+        cout << "Invalid max test success" << endl;
+    }
+    cout << "printing empty tree: " << endl;
+    t.print_tree();
+    cout << "Empty? should be 1: " << t.is_empty() << endl;
+    cout << endl;
+
+    // inserting, 1 to 7 in order should come out perfectly balanced
+    for (int i = 1; i <= 7; i++) {
+        t.insert(i);
+    }
+    t.print_tree();
+    cout << "Size: should be 7: " << t.size() << endl;
+    cout << "Min: should be 1: " << t.find_min() << endl;
+    cout << "Max: should be 7: " << t.find_max() << endl;
+    cout << "Inserting 4 again: should be 0: " << t.insert(4) << endl;
+    cout << "Size: should be 7: " << t.size() << endl;
+    cout << endl;
+
+    // removing
+    cout << "Removing 4(Root): should be 1: " << t.remove(4) << endl;
+    t.print_tree();
+    cout << "Removing 4 again: should be 0: " << t.remove(4) << endl;
+    cout << "Removing 1, 2, 3" << endl;
+    t.remove(1);
+    t.remove(2);
+    t.remove(3);
+    t.print_tree();
+    cout << "Size: should be 3: " << t.size() << endl;
+    cout << "Contains 3: should be 0: " << t.contains(3) << endl;
+    cout << "Contains 6: should be 1: " << t.contains(6) << endl;
+    t.make_empty();
+    cout << "Empty after make_empty: should be 1: " << t.is_empty() << endl;
+    cout << "Size: should be 0: " << t.size() << endl;
+    cout << endl;
+
+    // bigger tree against what it should hold
+    PersistentAVLTree<int> big;
+    for (int i = 0; i < 10000; i++) {
+        big.insert((i * 7919) % 10000);
+    }
+    for (int i = 0; i < 10000; i += 2) {
+        big.remove(i);
+    }
+    int wrong = 0;
+    for (int i = 0; i < 10000; i++) {
+        if (big.contains(i) != (i % 2 == 1)) {
+            wrong++;
+        }
+    }
+    cout << "Wrong answers after 10000 inserts and 5000 removes: should be 0: " << wrong << endl;
+    cout << "Size: should be 5000: " << big.size() << endl;
+    cout << "Min: should be 1: " << big.find_min() << endl;
+    cout << "Max: should be 9999: " << big.find_max() << endl;
+    cout << endl;
+
+    // readers while a writer runs - odd values stay the whole time, even values come and go
+    std::atomic<bool> done{false};
+    std::atomic<int> missing{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; r++) {
+        readers.emplace_back([&big, &done, &missing, r]() {
+            for (int i = r; !done.load(); i = (i + 4) % 10000) {
+                if (i % 2 == 1 && !big.contains(i)) {
+                    missing++;
+                }
+            }
+        });
+    }
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 10000; i += 2) {
+            big.insert(i);
+        }
+        for (int i = 0; i < 10000; i += 2) {
+            big.remove(i);
+        }
+    }
+    done.store(true);
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    cout << "Odd values readers missed during writes: should be 0: " << missing.load() << endl;
+    cout << "Size: should be 5000: " << big.size() << endl;
+    cout << endl;
+
+    // snapshots keep their version while the tree moves on
+    PersistentAVLTree<int> live;
+    for (int i = 1; i <= 10; i++) {
+        live.insert(i);
+    }
+    PersistentAVLTree<int>::Snapshot snap = live.snapshot();
+    live.remove(5);
+    live.insert(11);
+    live.make_empty();
+    live.insert(20);
+    cout << "Snapshot size: should be 10: " << snap.size() << endl;
+    cout << "Tree size: should be 1: " << live.size() << endl;
+    cout << "Snapshot contains 5: should be 1: " << snap.contains(5) << endl;
+    cout << "Snapshot contains 11: should be 0: " << snap.contains(11) << endl;
+    cout << "Snapshot min: should be 1: " << snap.find_min() << endl;
+    cout << "Snapshot max: should be 10: " << snap.find_max() << endl;
+    cout << "Snapshot in order: ";
+    for (int v : snap) {
+        cout << v << ' ';
+    }
+    cout << endl;
+    PersistentAVLTree<int>::Snapshot copy = snap;
+    snap = live.snapshot();
+    cout << "Copied snapshot size: should be 10: " << copy.size() << endl;
+    cout << "New snapshot max: should be 20: " << snap.find_max() << endl;
+    PersistentAVLTree<int>::Snapshot empty;
+    cout << "Empty snapshot: should be 1: " << empty.is_empty() << endl;
+    try {
+        empty.find_min();
+    }
+    catch (const std::invalid_argument&) {
+        cout << "Invalid snapshot min test success" << endl;
+    }
+    cout << endl;
+
+    // reading a snapshot from several threads while the writer keeps going
+    PersistentAVLTree<int>::Snapshot odds = big.snapshot();
+    std::atomic<int> wrongInSnapshot{0};
+    std::vector<std::thread> scanners;
+    for (int r = 0; r < 4; r++) {
+        scanners.emplace_back([&odds, &wrongInSnapshot]() {
+            int expected = 1;
+            for (int v : odds) {
+                if (v != expected) {
+                    wrongInSnapshot++;
+                }
+                expected += 2;
+            }
+        });
+    }
+    for (int i = 0; i < 10000; i += 2) {
+        big.insert(i);
+    }
+    for (int i = 1; i < 10000; i += 2) {
+        big.remove(i);
+    }
+    for (std::thread& scanner : scanners) {
+        scanner.join();
+    }
+    cout << "Values out of place in snapshot scans: should be 0: " << wrongInSnapshot.load() << endl;
+    cout << "Snapshot size: should be 5000: " << odds.size() << endl;
+    cout << "Tree min now: should be 0: " << big.find_min() << endl;
+    cout << endl;
+
+    // char tree
+    PersistentAVLTree<char> ct;
+    ct.insert('c');
+    ct.insert('a');
+    ct.insert('z');
+    ct.insert('b');
+    ct.print_tree();
+    cout << "Min val: should be a: " << ct.find_min() << endl;
+    cout << "Max val: should be z: " << ct.find_max() << endl;
+    return 0;
+}
@@ -0,0 +1,277 @@
+/*****************************************
+** File:    simd_search.h
+** Project: CSCE 221 Lab 4 Spring 2022
+** Author:  Naimur Rahman
+** Date:    03/21/2022
+** Section: 511
+** E-mail:  naimurrah01@tamu.edu
+** Description: Search helpers for the sorted key arrays of wide tree nodes, using SIMD compares for arithmetic keys
+**/
+#ifndef SIMD_SEARCH_H
+#define SIMD_SEARCH_H
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#if !defined(SIMD_SEARCH_SCALAR) && (defined(__SSE2__) || defined(__AVX2__))
+#include <immintrin.h>
+#endif
+
+// key_lower_bound() and key_upper_bound() find a key in a node's sorted array.
+// 32 and 64 bit integers, float and double compare a whole vector of keys with x
+// at once and count the lanes from the mask. The keys are sorted, so the first
+// vector that is not all below x holds the answer and the loop stops there: one
+// branch per node that can mispredict, where a binary search has one per level.
+// The instruction set is picked at compile time, AVX2 when built with -mavx2 or
+// -march=native and SSE2 otherwise on x86-64. Elsewhere, or with
+// SIMD_SEARCH_SCALAR defined, arithmetic keys are counted with a branch free
+// scalar loop, and any other Comparable falls back to std::lower_bound.
+
+// how an arithmetic key is compared in vector lanes
+enum class KeyLanes { NONE, SIGNED32, UNSIGNED32, SIGNED64, UNSIGNED64, FLOAT32, FLOAT64 };
+
+//-------------------------------------------------------
+// Name: keyLanes<T>()
+// PreCondition:  key type T
+// PostCondition: returns which vector compare handles T, NONE if no vector path does
+//---------------------------------------------------------
+template <typename T>
+constexpr KeyLanes keyLanes() {
+    if constexpr (std::is_same<T, float>::value) {
+        return KeyLanes::FLOAT32;
+    }
+    else if constexpr (std::is_same<T, double>::value) {
+        return KeyLanes::FLOAT64;
+    }
+    else if constexpr (std::is_integral<T>::value && !std::is_same<T, bool>::value && sizeof(T) == 4) {
+        return std::is_signed<T>::value ? KeyLanes::SIGNED32 : KeyLanes::UNSIGNED32;
+    }
+    else if constexpr (std::is_integral<T>::value && !std::is_same<T, bool>::value && sizeof(T) == 8) {
+        return std::is_signed<T>::value ? KeyLanes::SIGNED64 : KeyLanes::UNSIGNED64;
+    }
+    else {
+        return KeyLanes::NONE;
+    }
+}
+
+// vector compares for one kind of key. less() and greater() return a bit per lane
+// for keys below and above x. WIDTH is 0 when there is no vector path.
+template <KeyLanes Kind>
+struct SimdLanes {
+    static constexpr unsigned WIDTH = 0;
+};
+
+#if !defined(SIMD_SEARCH_SCALAR) && defined(__AVX2__)
+
+template <>
+struct SimdLanes<KeyLanes::SIGNED32> {
+    static constexpr unsigned WIDTH = 8;
+    using Vec = __m256i;
+    static Vec splat(std::int32_t x) { return _mm256_set1_epi32(x); }
+    static Vec load(const void* p) { return _mm256_loadu_si256(static_cast<const __m256i*>(p)); }
+    static unsigned mask(Vec v) { return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(v))); }
+    static unsigned less(const void* p, Vec x) { return mask(_mm256_cmpgt_epi32(x, load(p))); }
+    static unsigned greater(const void* p, Vec x) { return mask(_mm256_cmpgt_epi32(load(p), x)); }
+};
+
+// unsigned keys flip the sign bit so the signed compare orders them right
+template <>
+struct SimdLanes<KeyLanes::UNSIGNED32> {
+    static constexpr unsigned WIDTH = 8;
+    using Vec = __m256i;
+    static Vec bias() { return _mm256_set1_epi32(INT32_MIN); }
+    static Vec splat(std::uint32_t x) { return _mm256_xor_si256(_mm256_set1_epi32(static_cast<std::int32_t>(x)), bias()); }
+    static Vec load(const void* p) { return _mm256_xor_si256(_mm256_loadu_si256(static_cast<const __m256i*>(p)), bias()); }
+    static unsigned mask(Vec v) { return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(v))); }
+    static unsigned less(const void* p, Vec x) { return mask(_mm256_cmpgt_epi32(x, load(p))); }
+    static unsigned greater(const void* p, Vec x) { return mask(_mm256_cmpgt_epi32(load(p), x)); }
+};
+
+template <>
+struct SimdLanes<KeyLanes::SIGNED64> {
+    static constexpr unsigned WIDTH = 4;
+    using Vec = __m256i;
+    static Vec splat(std::int64_t x) { return _mm256_set1_epi64x(x); }
+    static Vec load(const void* p) { return _mm256_loadu_si256(static_cast<const __m256i*>(p)); }
+    static unsigned mask(Vec v) { return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(v))); }
+    static unsigned less(const void* p, Vec x) { return mask(_mm256_cmpgt_epi64(x, load(p))); }
+    static unsigned greater(const void* p, Vec x) { return mask(_mm256_cmpgt_epi64(load(p), x)); }
+};
+
+template <>
+struct SimdLanes<KeyLanes::UNSIGNED64> {
+    static constexpr unsigned WIDTH = 4;
+    using Vec = __m256i;
+    static Vec bias() { return _mm256_set1_epi64x(INT64_MIN); }
+    static Vec splat(std::uint64_t x) { return _mm256_xor_si256(_mm256_set1_epi64x(static_cast<std::int64_t>(x)), bias()); }
+    static Vec load(const void* p) { return _mm256_xor_si256(_mm256_loadu_si256(static_cast<const __m256i*>(p)), bias()); }
+    static unsigned mask(Vec v) { return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(v))); }
+    static unsigned less(const void* p, Vec x) { return mask(_mm256_cmpgt_epi64(x, load(p))); }
+    static unsigned greater(const void* p, Vec x) { return mask(_mm256_cmpgt_epi64(load(p), x)); }
+};
+
+template <>
+struct SimdLanes<KeyLanes::FLOAT32> {
+    static constexpr unsigned WIDTH = 8;
+    using Vec = __m256;
+    static Vec splat(float x) { return _mm256_set1_ps(x); }
+    static Vec load(const void* p) { return _mm256_loadu_ps(static_cast<const float*>(p)); }
+    static unsigned less(const void* p, Vec x) { return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(load(p), x, _CMP_LT_OQ))); }
+    static unsigned greater(const void* p, Vec x) { return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(load(p), x, _CMP_GT_OQ))); }
+};
+
+template <>
+struct SimdLanes<KeyLanes::FLOAT64> {
+    static constexpr unsigned WIDTH = 4;
+    using Vec = __m256d;
+    static Vec splat(double x) { return _mm256_set1_pd(x); }
+    static Vec load(const void* p) { return _mm256_loadu_pd(static_cast<const double*>(p)); }
+    static unsigned less(const void* p, Vec x) { return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(load(p), x, _CMP_LT_OQ))); }
+    static unsigned greater(const void* p, Vec x) { return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(load(p), x, _CMP_GT_OQ))); }
+};
+
+#elif !defined(SIMD_SEARCH_SCALAR) && defined(__SSE2__)
+
+template <>
+struct SimdLanes<KeyLanes::SIGNED32> {
+    static constexpr unsigned WIDTH = 4;
+    using Vec = __m128i;
+    static Vec splat(std::int32_t x) { return _mm_set1_epi32(x); }
+    static Vec load(const void* p) { return _mm_loadu_si128(static_cast<const __m128i*>(p)); }
+    static unsigned mask(Vec v) { return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(v))); }
+    static unsigned less(const void* p, Vec x) { return mask(_mm_cmpgt_epi32(x, load(p))); }
+    static unsigned greater(const void* p, Vec x) { return mask(_mm_cmpgt_epi32(load(p), x)); }
+};
+
+// unsigned keys flip the sign bit so the signed compare orders them right
+template <>
+struct SimdLanes<KeyLanes::UNSIGNED32> {
+    static constexpr unsigned WIDTH = 4;
+    using Vec = __m128i;
+    static Vec bias() { return _mm_set1_epi32(INT32_MIN); }
+    static Vec splat(std::uint32_t x) { return _mm_xor_si128(_mm_set1_epi32(static_cast<std::int32_t>(x)), bias()); }
+    static Vec load(const void* p) { return _mm_xor_si128(_mm_loadu_si128(static_cast<const __m128i*>(p)), bias()); }
+    static unsigned mask(Vec v) { return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(v))); }
+    static unsigned less(const void* p, Vec x) { return mask(_mm_cmpgt_epi32(x, load(p))); }
+    static unsigned greater(const void* p, Vec x) { return mask(_mm_cmpgt_epi32(load(p), x)); }
+};
+
+// SSE2 has no 64 bit integer compare, so those keys take the scalar loop
+
+template <>
+struct SimdLanes<KeyLanes::FLOAT32> {
+    static constexpr unsigned WIDTH = 4;
+    using Vec = __m128;
+    static Vec splat(float x) { return _mm_set1_ps(x); }
+    static Vec load(const void* p) { return _mm_loadu_ps(static_cast<const float*>(p)); }
+    static unsigned less(const void* p, Vec x) { return static_cast<unsigned>(_mm_movemask_ps(_mm_cmplt_ps(load(p), x))); }
+    static unsigned greater(const void* p, Vec x) { return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpgt_ps(load(p), x))); }
+};
+
+template <>
+struct SimdLanes<KeyLanes::FLOAT64> {
+    static constexpr unsigned WIDTH = 2;
+    using Vec = __m128d;
+    static Vec splat(double x) { return _mm_set1_pd(x); }
+    static Vec load(const void* p) { return _mm_loadu_pd(static_cast<const double*>(p)); }
+    static unsigned less(const void* p, Vec x) { return static_cast<unsigned>(_mm_movemask_pd(_mm_cmplt_pd(load(p), x))); }
+    static unsigned greater(const void* p, Vec x) { return static_cast<unsigned>(_mm_movemask_pd(_mm_cmpgt_pd(load(p), x))); }
+};
+
+#endif
+
+//-------------------------------------------------------
+// Name: key_search_width<T>()
+// PreCondition:  key type T
+// PostCondition: returns how many keys of type T one compare covers, 1 without a vector path
+//---------------------------------------------------------
+template <typename T>
+constexpr unsigned key_search_width() {
+    return std::max(SimdLanes<keyLanes<T>()>::WIDTH, 1u);
+}
+
+//-------------------------------------------------------
+// Name: key_search_isa()
+// PreCondition:  none
+// PostCondition: returns the name of the instruction set the vector compares were built for
+//---------------------------------------------------------
+inline const char* key_search_isa() {
+#if !defined(SIMD_SEARCH_SCALAR) && defined(__AVX2__)
+    return "avx2";
+#elif !defined(SIMD_SEARCH_SCALAR) && defined(__SSE2__)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+//-------------------------------------------------------
+// Name: key_lower_bound(const T* keys, unsigned n, const T& x)
+// PreCondition:  n keys in order and key x given
+// PostCondition: returns the index of the first key not less than x, n if there is none
+//---------------------------------------------------------
+template <typename T>
+unsigned key_lower_bound(const T* keys, unsigned n, const T& x) {
+    using Lanes = SimdLanes<keyLanes<T>()>;
+    if constexpr (Lanes::WIDTH > 0) {
+        const unsigned all = (1u << Lanes::WIDTH) - 1;
+        typename Lanes::Vec v = Lanes::splat(x);
+        unsigned i = 0;
+        for (; i + Lanes::WIDTH <= n; i += Lanes::WIDTH) {
+            unsigned below = Lanes::less(keys + i, v);
+            if (below != all) { // answer is in this vector, after the keys below x
+                return i + static_cast<unsigned>(__builtin_popcount(below));
+            }
+        }
+        while (i < n && keys[i] < x) { // fewer than WIDTH keys left
+            i++;
+        }
+        return i;
+    }
+    else if constexpr (std::is_arithmetic<T>::value) {
+        unsigned below = 0;
+        for (unsigned i = 0; i < n; i++) { // no branch to mispredict, and compilers vectorize it
+            below += keys[i] < x;
+        }
+        return below;
+    }
+    else {
+        return static_cast<unsigned>(std::lower_bound(keys, keys + n, x) - keys);
+    }
+}
+
+//-------------------------------------------------------
+// Name: key_upper_bound(const T* keys, unsigned n, const T& x)
+// PreCondition:  n keys in order and key x given
+// PostCondition: returns the index of the first key greater than x, n if there is none
+//---------------------------------------------------------
+template <typename T>
+unsigned key_upper_bound(const T* keys, unsigned n, const T& x) {
+    using Lanes = SimdLanes<keyLanes<T>()>;
+    if constexpr (Lanes::WIDTH > 0) {
+        typename Lanes::Vec v = Lanes::splat(x);
+        unsigned i = 0;
+        for (; i + Lanes::WIDTH <= n; i += Lanes::WIDTH) {
+            unsigned above = Lanes::greater(keys + i, v);
+            if (above != 0) { // answer is in this vector, at the first key above x
+                return i + static_cast<unsigned>(__builtin_ctz(above));
+            }
+        }
+        while (i < n && !(x < keys[i])) { // fewer than WIDTH keys left
+            i++;
+        }
+        return i;
+    }
+    else if constexpr (std::is_arithmetic<T>::value) {
+        unsigned notAbove = 0;
+        for (unsigned i = 0; i < n; i++) { // no branch to mispredict, and compilers vectorize it
+            notAbove += !(x < keys[i]);
+        }
+        return notAbove;
+    }
+    else {
+        return static_cast<unsigned>(std::upper_bound(keys, keys + n, x) - keys);
+    }
+}
+
+#endif
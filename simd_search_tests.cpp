@@ -0,0 +1,102 @@
+/*****************************************
+** File:    simd_search_tests.cpp
+** Project: CSCE 221 Lab 4 Spring 2022
+** Author:  Naimur Rahman
+** Date:    03/21/2022
+** Section: 511
+** E-mail:  naimurrah01@tamu.edu
+** Description: Tests for the key search helpers in simd_search.h
+**/
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include "simd_search.h"
+
+using std::cout, std::endl;
+
+//-------------------------------------------------------
+// Name: randomKey<T>(std::mt19937_64& gen)
+// PreCondition:  key type T and a random generator
+// PostCondition: returns a key from anywhere in the range of T, small ones for floating point
+//---------------------------------------------------------
+template <typename T>
+T randomKey(std::mt19937_64& gen) {
+    if constexpr (std::is_floating_point<T>::value) {
+        return static_cast<T>(std::uniform_real_distribution<double>(-1e6, 1e6)(gen));
+    }
+    else {
+        return static_cast<T>(gen());
+    }
+}
+
+//-------------------------------------------------------
+// Name: wrongAnswers<T>(std::mt19937_64& gen)
+// PreCondition:  key type T and a random generator
+// PostCondition: returns how many searches of sorted arrays of every length up to 70 disagree with
+//                std::lower_bound and std::upper_bound, probing every key, its neighbours and both ends
+//---------------------------------------------------------
+template <typename T>
+int wrongAnswers(std::mt19937_64& gen) {
+    int wrong = 0;
+    for (unsigned length = 0; length <= 70; length++) {
+        std::vector<T> keys;
+        for (unsigned i = 0; i < length; i++) {
+            keys.push_back(randomKey<T>(gen));
+        }
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        unsigned n = static_cast<unsigned>(keys.size());
+
+        std::vector<T> probes(keys);
+        for (T k : keys) {
+            if (k > std::numeric_limits<T>::lowest()) {
+                probes.push_back(static_cast<T>(k - 1));
+            }
+            if (k < std::numeric_limits<T>::max()) {
+                probes.push_back(static_cast<T>(k + 1));
+            }
+        }
+        probes.push_back(std::numeric_limits<T>::lowest());
+        probes.push_back(std::numeric_limits<T>::max());
+        for (T x : probes) {
+            unsigned lower = static_cast<unsigned>(std::lower_bound(keys.begin(), keys.end(), x) - keys.begin());
+            unsigned upper = static_cast<unsigned>(std::upper_bound(keys.begin(), keys.end(), x) - keys.begin());
+            wrong += key_lower_bound(keys.data(), n, x) != lower;
+            wrong += key_upper_bound(keys.data(), n, x) != upper;
+        }
+    }
+    return wrong;
+}
+
+int main() {
+    std::mt19937_64 gen(221);
+    cout << "Instruction set: " << key_search_isa() << endl;
+    cout << "int keys per compare: " << key_search_width<int>() << endl;
+    cout << "double keys per compare: " << key_search_width<double>() << endl;
+    cout << "string keys per compare: should be 1: " << key_search_width<std::string>() << endl;
+    cout << endl;
+
+    cout << "int wrong: should be 0: " << wrongAnswers<std::int32_t>(gen) << endl;
+    cout << "unsigned wrong: should be 0: " << wrongAnswers<std::uint32_t>(gen) << endl;
+    cout << "long long wrong: should be 0: " << wrongAnswers<long long>(gen) << endl;
+    cout << "unsigned long wrong: should be 0: " << wrongAnswers<std::uint64_t>(gen) << endl;
+    cout << "float wrong: should be 0: " << wrongAnswers<float>(gen) << endl;
+    cout << "double wrong: should be 0: " << wrongAnswers<double>(gen) << endl;
+    cout << "short wrong: should be 0: " << wrongAnswers<short>(gen) << endl;
+    cout << endl;
+
+    // repeated keys, which the trees never hold but the helpers still handle
+    int repeated[] = {1, 2, 2, 2, 2, 2, 2, 2, 2, 3};
+    cout << "lower bound of 2: should be 1: " << key_lower_bound(repeated, 10, 2) << endl;
+    cout << "upper bound of 2: should be 9: " << key_upper_bound(repeated, 10, 2) << endl;
+
+    // anything not arithmetic takes std::lower_bound
+    std::string words[] = {"apple", "kiwi", "pear"};
+    cout << "lower bound of banana: should be 1: " << key_lower_bound(words, 3, std::string("banana")) << endl;
+    cout << "upper bound of pear: should be 3: " << key_upper_bound(words, 3, std::string("pear")) << endl;
+    return 0;
+}
@@ -0,0 +1,74 @@
+/*****************************************
+** File:    three_way.h
+** Project: CSCE 221 Lab 4 Spring 2022
+** Author:  Naimur Rahman
+** Date:    03/21/2022
+** Section: 511
+** E-mail:  naimurrah01@tamu.edu
+** Description: Three-way comparison through a comparator, for the trees to walk down with one comparison per node
+**/
+#ifndef THREE_WAY_H
+#define THREE_WAY_H
+
+#include <functional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// three_way(comp, a, b) tells in one go whether a goes before, with or after b
+// in the order of comp, so a tree can pick its way down at a node without first
+// asking == and then > or <. How many real comparisons that costs depends on comp:
+//  - a comparator with a three_way(a, b) member is asked that, as TreeMap's is
+//  - std::less on two strings, or anything else std::string_view is made from
+//    without a copy, is one compare() pass over the characters
+//  - std::less on two arithmetic values of one type is two cheap compares with no branch
+//  - any other comparator is called twice, a against b and then b against a
+// C++17 has no operator<=>, so this stands in for it.
+
+// true for std::less of any type, including the transparent std::less<>
+template <typename Compare>
+struct IsStdLess : std::false_type {};
+
+template <typename T>
+struct IsStdLess<std::less<T>> : std::true_type {};
+
+// true when comp has a three_way(a, b) member of its own
+template <typename Compare, typename A, typename B, typename = void>
+struct HasThreeWay : std::false_type {};
+
+template <typename Compare, typename A, typename B>
+struct HasThreeWay<Compare, A, B, std::void_t<decltype(std::declval<const Compare&>().three_way(
+                                      std::declval<const A&>(), std::declval<const B&>()))>> : std::true_type {};
+
+// true for string types that are viewed as a std::string_view without copying, not for char pointers
+template <typename T>
+struct IsStringView
+    : std::integral_constant<bool, std::is_convertible<const T&, std::string_view>::value &&
+                                       !std::is_pointer<typename std::decay<T>::type>::value> {};
+
+//-------------------------------------------------------
+// Name: three_way(const Compare& comp, const A& a, const B& b)
+// PreCondition:  comparator comp that takes a and b both ways round
+// PostCondition: returns a negative number if a goes before b, 0 if neither goes before the other,
+//                and a positive number if a goes after b
+//---------------------------------------------------------
+template <typename Compare, typename A, typename B>
+int three_way(const Compare& comp, const A& a, const B& b) {
+    if constexpr (HasThreeWay<Compare, A, B>::value) {
+        return comp.three_way(a, b);
+    }
+    else if constexpr (IsStdLess<Compare>::value && IsStringView<A>::value && IsStringView<B>::value) {
+        return std::string_view(a).compare(std::string_view(b));
+    }
+    else if constexpr (IsStdLess<Compare>::value && std::is_arithmetic<A>::value && std::is_same<A, B>::value) {
+        return static_cast<int>(b < a) - static_cast<int>(a < b);
+    }
+    else {
+        if (comp(a, b)) {
+            return -1;
+        }
+        return comp(b, a) ? 1 : 0;
+    }
+}
+
+#endif
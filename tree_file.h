@@ -0,0 +1,140 @@
+/*****************************************
+** File:    tree_file.h
+** Project: CSCE 221 Lab 4 Spring 2022
+** Author:  Naimur Rahman
+** Date:    03/21/2022
+** Section: 511
+** E-mail:  naimurrah01@tamu.edu
+** Description: Binary file format the trees are saved in, read back by load() and by MappedTree
+**/
+#ifndef TREE_FILE_H
+#define TREE_FILE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// A tree file is a 32 byte header followed by the values in sorted order,
+// each one stored as its bytes in memory. No shape is stored: a sorted run is
+// enough to build a perfectly balanced tree in O(n), and to binary search
+// straight from the file once it is mapped. Values therefore have to be
+// trivially copyable (ints, doubles, plain structs), and the file can only be
+// read on a machine with the same byte order, which the header records.
+struct TreeFileHeader {
+    char magic[8];           // TREE_FILE_MAGIC
+    std::uint32_t version;   // TREE_FILE_VERSION of the writer
+    std::uint32_t byteOrder; // TREE_FILE_BYTE_ORDER as the writer stored it
+    std::uint64_t keySize;   // sizeof one value
+    std::uint64_t count;     // number of values after the header
+};
+
+constexpr char TREE_FILE_MAGIC[8] = {'A', 'V', 'L', 'B', 'S', 'T', 'K', 0};
+constexpr std::uint32_t TREE_FILE_VERSION = 1;
+constexpr std::uint32_t TREE_FILE_BYTE_ORDER = 0x01020304;
+constexpr std::size_t TREE_FILE_CHUNK = 1 << 16; // bytes of values written at a time
+
+static_assert(sizeof(TreeFileHeader) == 32, "values start 32 bytes in, aligned for any of them");
+
+//-------------------------------------------------------
+// Name: checkTreeFileHeader(const TreeFileHeader& header, std::size_t keySize, std::uint64_t fileSize,
+//                           const std::string& path)
+// PreCondition:  header read from the file at path of fileSize bytes, and the size of the values expected in it
+// PostCondition: throws std::runtime_error if the header is not one this version can read or the file
+//                does not hold as many values as the header says
+//---------------------------------------------------------
+inline void checkTreeFileHeader(const TreeFileHeader& header, std::size_t keySize, std::uint64_t fileSize,
+                                const std::string& path) {
+    if (std::memcmp(header.magic, TREE_FILE_MAGIC, sizeof(TREE_FILE_MAGIC)) != 0) {
+        throw std::runtime_error(path + " is not a tree file");
+    }
+    if (header.version != TREE_FILE_VERSION) {
+        throw std::runtime_error(path + " has tree file version " + std::to_string(header.version) +
+                                 ", expected " + std::to_string(TREE_FILE_VERSION));
+    }
+    if (header.byteOrder != TREE_FILE_BYTE_ORDER) {
+        throw std::runtime_error(path + " was written with a different byte order");
+    }
+    if (header.keySize != keySize) {
+        throw std::runtime_error(path + " holds values of " + std::to_string(header.keySize) +
+                                 " bytes, expected " + std::to_string(keySize));
+    }
+    if ((fileSize - sizeof(header)) % keySize != 0 || (fileSize - sizeof(header)) / keySize != header.count) {
+        throw std::runtime_error(path + " is cut short or has extra bytes");
+    }
+}
+
+//-------------------------------------------------------
+// Name: write_tree_file<Comparable>(const std::string& path, InputIt first, std::size_t n)
+// PreCondition:  n values in sorted order starting at first
+// PostCondition: writes them as a tree file at path, throwing std::runtime_error if that fails. The file
+//                is written beside path and renamed over it at the end, so a reader never sees half of it.
+//---------------------------------------------------------
+template <typename Comparable, typename InputIt>
+void write_tree_file(const std::string& path, InputIt first, std::size_t n) {
+    static_assert(std::is_trivially_copyable<Comparable>::value, "tree files store values as their bytes");
+    TreeFileHeader header = {};
+    std::memcpy(header.magic, TREE_FILE_MAGIC, sizeof(TREE_FILE_MAGIC));
+    header.version = TREE_FILE_VERSION;
+    header.byteOrder = TREE_FILE_BYTE_ORDER;
+    header.keySize = sizeof(Comparable);
+    header.count = n;
+
+    std::string temp = path + ".tmp";
+    std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // tree values are not next to each other in memory, so gather them into chunks
+    std::vector<Comparable> chunk;
+    chunk.reserve(std::max<std::size_t>(1, TREE_FILE_CHUNK / sizeof(Comparable)));
+    for (std::size_t i = 0; i < n && out; i++, ++first) {
+        chunk.push_back(*first);
+        if (chunk.size() == chunk.capacity() || i + 1 == n) {
+            out.write(reinterpret_cast<const char*>(chunk.data()),
+                      static_cast<std::streamsize>(chunk.size() * sizeof(Comparable)));
+            chunk.clear();
+        }
+    }
+    out.close();
+    if (!out || std::rename(temp.c_str(), path.c_str()) != 0) {
+        std::remove(temp.c_str());
+        throw std::runtime_error("could not write tree file " + path);
+    }
+}
+
+//-------------------------------------------------------
+// Name: read_tree_file<Comparable>(const std::string& path)
+// PreCondition:  path of a tree file of Comparable values
+// PostCondition: returns the values of the file in the order they were saved, throwing std::runtime_error
+//                if it cannot be read or does not hold Comparable values
+//---------------------------------------------------------
+template <typename Comparable>
+std::vector<Comparable> read_tree_file(const std::string& path) {
+    static_assert(std::is_trivially_copyable<Comparable>::value, "tree files store values as their bytes");
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        throw std::runtime_error("could not open tree file " + path);
+    }
+    std::uint64_t fileSize = static_cast<std::uint64_t>(in.tellg());
+    in.seekg(0);
+    TreeFileHeader header = {};
+    if (fileSize < sizeof(header) || !in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        throw std::runtime_error(path + " is not a tree file");
+    }
+    checkTreeFileHeader(header, sizeof(Comparable), fileSize, path);
+
+    std::vector<Comparable> values(static_cast<std::size_t>(header.count));
+    if (!in.read(reinterpret_cast<char*>(values.data()),
+                 static_cast<std::streamsize>(values.size() * sizeof(Comparable)))) {
+        throw std::runtime_error("could not read tree file " + path);
+    }
+    return values;
+}
+
+#endif
@@ -0,0 +1,319 @@
+/*****************************************
+** File:    tree_map.h
+** Project: CSCE 221 Lab 4 Spring 2022
+** Author:  Naimur Rahman
+** Date:    03/21/2022
+** Section: 511
+** E-mail:  naimurrah01@tamu.edu
+** Description: Implementation for TreeMap class, with AVLMap and BSTMap on top of AVLTree and BinarySearchTree
+**/
+#ifndef TREE_MAP_H
+#define TREE_MAP_H
+
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <utility>
+#include "avl_tree.h"
+#include "binary_search_tree.h"
+#include "node_pool.h"
+#include "three_way.h"
+
+// One entry of a map: a key and the value stored with it in the same tree node.
+template <typename Key, typename Value>
+struct MapEntry {
+    const Key first; // key, fixed while the entry is in the tree
+    Value second;    // value stored with the key
+
+    //-------------------------------------------------------
+    // Name: MapEntry(std::piecewise_construct_t, K&& key, Args&&... args)
+    // PreCondition: key and arguments for a Value constructor given, no arguments meaning a value initialized Value
+    // PostCondition: creates an entry holding key and a Value built in place from args
+    //---------------------------------------------------------
+    template <typename K, typename... Args>
+    MapEntry(std::piecewise_construct_t, K&& key, Args&&... args)
+        : first(std::forward<K>(key)), second(std::forward<Args>(args)...) {}
+
+    // entries print as "key: value", for print_tree()
+    friend std::ostream& operator<<(std::ostream& os, const MapEntry& e) { return os << e.first << ": " << e.second; }
+};
+
+// Orders the entries of a map by key with KeyCompare. It compares entries with bare
+// keys as well, so the tree can be searched for a key without building an entry
+// first, and answers three_way() with one three_way() on the keys.
+template <typename Key, typename Value, typename KeyCompare>
+struct EntryCompare {
+    using key_compare = KeyCompare;
+    using is_transparent = void; // entries and keys mix
+
+    KeyCompare keyComp; // order of the keys
+
+    //-------------------------------------------------------
+    // Name: keyOf(const MapEntry<Key, Value>& e) / keyOf(const K& key)
+    // PreCondition:  entry e or a key given
+    // PostCondition: returns the key of e, or the key itself
+    //---------------------------------------------------------
+    static const Key& keyOf(const MapEntry<Key, Value>& e) { return e.first; }
+
+    template <typename K>
+    static const K& keyOf(const K& key) { return key; }
+
+    //-------------------------------------------------------
+    // Name: operator()(const A& a, const B& b) / three_way(const A& a, const B& b)
+    // PreCondition:  entries or keys a and b given
+    // PostCondition: compares the keys of a and b with KeyCompare, see three_way.h
+    //---------------------------------------------------------
+    template <typename A, typename B>
+    bool operator()(const A& a, const B& b) const { return this->keyComp(keyOf(a), keyOf(b)); }
+
+    template <typename A, typename B>
+    int three_way(const A& a, const B& b) const { return ::three_way(this->keyComp, keyOf(a), keyOf(b)); }
+};
+
+// Map from Key to Value kept in a Tree of MapEntry, with each value stored inline in
+// the node of its key, so a record costs one node and every operation one walk down.
+// The map searches the tree by key with its findSlot(), findNode() and removeKey(),
+// ordered by EntryCompare, and builds the entry of a new key only once the walk has
+// found where it goes.
+template <typename Key, typename Value, typename Tree>
+class TreeMap {
+private:
+    Tree tree; // entries, ordered by key
+
+    //-------------------------------------------------------
+    // Name: emplaceKey(K&& key, Args&&... args)
+    // PreCondition: key and arguments for a Value constructor given
+    // PostCondition: adds an entry for key with a Value built from args if key is not in the map yet, leaving
+    //                args untouched otherwise. Returns the entry of key and whether it was added.
+    //---------------------------------------------------------
+    template <typename K, typename... Args>
+    std::pair<typename Tree::const_iterator, bool> emplaceKey(K&& key, Args&&... args) {
+        decltype(this->tree.root) parent;
+        auto link = this->tree.findSlot(key, parent);
+        auto n = this->tree.insertAt(link, parent, std::piecewise_construct, std::forward<K>(key), std::forward<Args>(args)...);
+        return {this->tree.iteratorTo(n), link != nullptr};
+    }
+
+    //-------------------------------------------------------
+    // Name: assignKey(K&& key, M&& value)
+    // PreCondition: key and value given
+    // PostCondition: assigns value to the entry of key, adding one if key is not in the map yet.
+    //                Returns the entry of key and whether it was added.
+    //---------------------------------------------------------
+    template <typename K, typename M>
+    std::pair<typename Tree::const_iterator, bool> assignKey(K&& key, M&& value) {
+        decltype(this->tree.root) parent;
+        auto link = this->tree.findSlot(key, parent);
+        if (link == nullptr) { // key in map already, parent holds it
+            parent->data.second = std::forward<M>(value);
+            return {this->tree.iteratorTo(parent), false};
+        }
+        auto n = this->tree.insertAt(link, parent, std::piecewise_construct, std::forward<K>(key), std::forward<M>(value));
+        return {this->tree.iteratorTo(n), true};
+    }
+
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = MapEntry<Key, Value>;
+    using key_compare = typename Tree::key_compare::key_compare;
+    using const_iterator = typename Tree::const_iterator;
+
+    //-------------------------------------------------------
+    // Name: iterator
+    // Description: bidirectional in-order iterator over the entries whose values can be changed,
+    //              the keys staying const
+    //---------------------------------------------------------
+    class iterator {
+    private:
+        const_iterator it; // entry in the tree
+
+        explicit iterator(const_iterator it) : it(it) {}
+        friend class TreeMap;
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = MapEntry<Key, Value>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = value_type*;
+        using reference = value_type&;
+
+        iterator() = default;
+
+        // the nodes of the tree are not const, only read through const_iterator
+        reference operator*() const { return const_cast<reference>(*this->it); }
+        pointer operator->() const { return &**this; }
+
+        iterator& operator++() {
+            ++this->it;
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator old = *this;
+            ++this->it;
+            return old;
+        }
+
+        iterator& operator--() {
+            --this->it;
+            return *this;
+        }
+
+        iterator operator--(int) {
+            iterator old = *this;
+            --this->it;
+            return old;
+        }
+
+        operator const_iterator() const { return this->it; }
+
+        bool operator==(const iterator& rhs) const { return this->it == rhs.it; }
+        bool operator!=(const iterator& rhs) const { return this->it != rhs.it; }
+    };
+
+    //-------------------------------------------------------
+    // Name: find(const Key& key)
+    // PreCondition: Key key passed by reference
+    // PostCondition: returns an iterator to the entry of key, end() if key is not in the map
+    //---------------------------------------------------------
+    iterator find(const Key& key) { return iterator(this->tree.iteratorTo(this->tree.findNode(key))); }
+    const_iterator find(const Key& key) const { return this->tree.iteratorTo(this->tree.findNode(key)); }
+
+    //-------------------------------------------------------
+    // Name: find(const K& key)
+    // PreCondition: key that key_compare can compare with the keys, only when key_compare is transparent like std::less<>
+    // PostCondition: returns an iterator to the entry of the equivalent key, end() if there is none, without building a Key
+    //---------------------------------------------------------
+    template <typename K, typename C = key_compare, typename = typename C::is_transparent>
+    iterator find(const K& key) { return iterator(this->tree.iteratorTo(this->tree.findNode(key))); }
+
+    template <typename K, typename C = key_compare, typename = typename C::is_transparent>
+    const_iterator find(const K& key) const { return this->tree.iteratorTo(this->tree.findNode(key)); }
+
+    //-------------------------------------------------------
+    // Name: contains(const Key& key)
+    // PreCondition: Key key passed by reference
+    // PostCondition: return true if key is in the map, false if not
+    //---------------------------------------------------------
+    bool contains(const Key& key) const { return this->tree.findNode(key) != nullptr; }
+
+    //-------------------------------------------------------
+    // Name: contains(const K& key)
+    // PreCondition: key that key_compare can compare with the keys, only when key_compare is transparent like std::less<>
+    // PostCondition: return true if an equivalent key is in the map, without building a Key
+    //---------------------------------------------------------
+    template <typename K, typename C = key_compare, typename = typename C::is_transparent>
+    bool contains(const K& key) const { return this->tree.findNode(key) != nullptr; }
+
+    //-------------------------------------------------------
+    // Name: operator[](const Key& key) / operator[](Key&& key)
+    // PreCondition: Key key given as an lvalue or rvalue
+    // PostCondition: returns the value of key, adding key with a value initialized Value first if it is not in the map
+    //---------------------------------------------------------
+    Value& operator[](const Key& key) { return iterator(emplaceKey(key).first)->second; }
+    Value& operator[](Key&& key) { return iterator(emplaceKey(std::move(key)).first)->second; }
+
+    //-------------------------------------------------------
+    // Name: try_emplace(const Key& key, Args&&... args)
+    // PreCondition: Key key and arguments for a Value constructor given
+    // PostCondition: adds key with a Value built in place from args if key is not in the map, and does nothing
+    //                otherwise, not even moving from args. Returns an iterator to the entry of key and whether
+    //                it was added.
+    //---------------------------------------------------------
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+        std::pair<const_iterator, bool> result = emplaceKey(key, std::forward<Args>(args)...);
+        return {iterator(result.first), result.second};
+    }
+
+    //-------------------------------------------------------
+    // Name: try_emplace(Key&& key, Args&&... args)
+    // PreCondition: Key key as an rvalue and arguments for a Value constructor given
+    // PostCondition: same as try_emplace(const Key&, Args&&...), moving key into the map only if it is added
+    //---------------------------------------------------------
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+        std::pair<const_iterator, bool> result = emplaceKey(std::move(key), std::forward<Args>(args)...);
+        return {iterator(result.first), result.second};
+    }
+
+    //-------------------------------------------------------
+    // Name: insert_or_assign(const Key& key, M&& value)
+    // PreCondition: Key key and a value that can be assigned to a Value given
+    // PostCondition: assigns value to key, adding key if it is not in the map.
+    //                Returns an iterator to the entry of key and whether it was added.
+    //---------------------------------------------------------
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(const Key& key, M&& value) {
+        std::pair<const_iterator, bool> result = assignKey(key, std::forward<M>(value));
+        return {iterator(result.first), result.second};
+    }
+
+    //-------------------------------------------------------
+    // Name: insert_or_assign(Key&& key, M&& value)
+    // PreCondition: Key key as an rvalue and a value that can be assigned to a Value given
+    // PostCondition: same as insert_or_assign(const Key&, M&&), moving key into the map only if it is added
+    //---------------------------------------------------------
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(Key&& key, M&& value) {
+        std::pair<const_iterator, bool> result = assignKey(std::move(key), std::forward<M>(value));
+        return {iterator(result.first), result.second};
+    }
+
+    //-------------------------------------------------------
+    // Name: erase(const Key& key)
+    // PreCondition: Key key passed by reference
+    // PostCondition: removes the entry of key and returns 1, or returns 0 if key is not in the map
+    //---------------------------------------------------------
+    std::size_t erase(const Key& key) { return this->tree.removeKey(key) ? 1 : 0; }
+
+    //-------------------------------------------------------
+    // Name: begin() / end()
+    // PreCondition: none
+    // PostCondition: iterators to the entry with the smallest key and one past the largest
+    //---------------------------------------------------------
+    iterator begin() { return iterator(this->tree.begin()); }
+    iterator end() { return iterator(this->tree.end()); }
+    const_iterator begin() const { return this->tree.begin(); }
+    const_iterator end() const { return this->tree.end(); }
+
+    //-------------------------------------------------------
+    // Name: print_tree(std::ostream& os=std::cout)
+    // PreCondition: ostream os defaults to cout if none given
+    // PostCondition: prints 90 degree rotated tree of "key: value" entries to os
+    //---------------------------------------------------------
+    void print_tree(std::ostream& os=std::cout) const { this->tree.print_tree(os); }
+
+    //-------------------------------------------------------
+    // Name: size()
+    // PreCondition: none
+    // PostCondition: returns the number of entries in the map
+    //---------------------------------------------------------
+    std::size_t size() const { return this->tree.size(); }
+
+    //-------------------------------------------------------
+    // Name: is_empty()
+    // PreCondition: none
+    // PostCondition: returns true if map is empty, false if it isnt
+    //---------------------------------------------------------
+    bool is_empty() const { return this->tree.is_empty(); }
+
+    //-------------------------------------------------------
+    // Name: make_empty()
+    // PreCondition: none
+    // PostCondition: removes every entry from the map
+    //---------------------------------------------------------
+    void make_empty() { this->tree.make_empty(); }
+};
+
+// map on a balanced AVLTree
+template <typename Key, typename Value, template <typename> class NodeAllocator = NodePool, typename Compare = std::less<Key>>
+using AVLMap = TreeMap<Key, Value, AVLTree<MapEntry<Key, Value>, NodeAllocator, EntryCompare<Key, Value, Compare>>>;
+
+// map on an unbalanced BinarySearchTree
+template <typename Key, typename Value, template <typename> class NodeAllocator = NodePool, typename Compare = std::less<Key>>
+using BSTMap = TreeMap<Key, Value, BinarySearchTree<MapEntry<Key, Value>, NodeAllocator, EntryCompare<Key, Value, Compare>>>;
+
+#endif
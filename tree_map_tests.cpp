@@ -0,0 +1,148 @@
+/*****************************************
+** File:    tree_map_tests.cpp
+** Project: CSCE 221 Lab 4 Spring 2022
+** Author:  Naimur Rahman
+** Date:    03/21/2022
+** Section: 511
+** E-mail:  naimurrah01@tamu.edu
+** Description: Tests for TreeMap Class, AVLMap and BSTMap
+**/
+#include <iostream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include "tree_map.h"
+
+using std::cout, std::endl;
+
+int main() {
+    AVLMap<std::string, int> m;
+    cout << "printing empty map: " << endl;
+    m.print_tree();
+    cout << "Empty? should be 1: " << m.is_empty() << endl;
+    cout << "Find on empty is end: should be 1: " << (m.find("a") == m.end()) << endl;
+    cout << "Erase on empty: should be 0: " << m.erase("a") << endl;
+    cout << endl;
+
+    // operator[] adds missing keys with a value initialized value
+    std::string words[] = {"pear", "apple", "fig", "apple", "kiwi", "pear", "apple"};
+    for (const std::string& w : words) {
+        m[w]++;
+    }
+    m.print_tree();
+    cout << "Size: should be 4: " << m.size() << endl;
+    cout << "apple: should be 3: " << m["apple"] << endl;
+    cout << "pear: should be 2: " << m.find("pear")->second << endl;
+    cout << "Contains plum: should be 0: " << m.contains("plum") << endl;
+    cout << "In order: should be apple fig kiwi pear: ";
+    for (const MapEntry<std::string, int>& e : m) {
+        cout << e.first << ' ';
+    }
+    cout << endl;
+    cout << endl;
+
+    // try_emplace leaves existing values alone, insert_or_assign replaces them
+    cout << "try_emplace fig added: should be 0: " << m.try_emplace("fig", 100).second << endl;
+    cout << "fig: should be 1: " << m["fig"] << endl;
+    cout << "try_emplace plum added: should be 1: " << m.try_emplace("plum", 100).second << endl;
+    cout << "plum: should be 100: " << m["plum"] << endl;
+    cout << "insert_or_assign fig added: should be 0: " << m.insert_or_assign("fig", 7).second << endl;
+    cout << "fig: should be 7: " << m.find("fig")->second << endl;
+    std::pair<AVLMap<std::string, int>::iterator, bool> r = m.insert_or_assign("grape", 5);
+    cout << "insert_or_assign grape added: should be 1: " << r.second << endl;
+    r.first->second += 1;
+    cout << "grape changed through iterator: should be 6: " << m["grape"] << endl;
+    cout << endl;
+
+    // try_emplace does not move from its arguments when the key is there
+    AVLMap<int, std::unique_ptr<int>> owners;
+    owners.try_emplace(1, new int(10));
+    std::unique_ptr<int> p(new int(20));
+    owners.try_emplace(1, std::move(p));
+    cout << "Argument kept when key exists: should be 1: " << (p != nullptr) << endl;
+    cout << "Value of 1: should be 10: " << *owners[1] << endl;
+    cout << endl;
+
+    // erasing
+    cout << "Erase apple: should be 1: " << m.erase("apple") << endl;
+    cout << "Erase apple again: should be 0: " << m.erase("apple") << endl;
+    cout << "Size: should be 5: " << m.size() << endl;
+    cout << "Find apple is end: should be 1: " << (m.find("apple") == m.end()) << endl;
+    cout << endl;
+
+    // copying keeps the values apart
+    AVLMap<std::string, int> cop(m);
+    cop["kiwi"] = 50;
+    cout << "Copy kiwi: should be 50: " << cop["kiwi"] << endl;
+    cout << "Original kiwi: should be 1: " << m["kiwi"] << endl;
+    const AVLMap<std::string, int>& cm = cop;
+    cout << "Find through const map: should be 50: " << cm.find("kiwi")->second << endl;
+    m.make_empty();
+    cout << "Empty after make_empty: should be 1: " << m.is_empty() << endl;
+    cout << endl;
+
+    // many keys
+    AVLMap<int, int> squares;
+    for (int i = 0; i < 100000; i++) {
+        squares[(i * 7919) % 100000] = 0;
+    }
+    for (int i = 0; i < 100000; i++) {
+        squares.insert_or_assign(i, i % 1000 * (i % 1000));
+    }
+    for (int i = 0; i < 100000; i += 2) {
+        squares.erase(i);
+    }
+    int wrong = 0;
+    for (int i = 0; i < 100000; i++) {
+        AVLMap<int, int>::iterator it = squares.find(i);
+        if (i % 2 == 0) {
+            wrong += (it != squares.end());
+        }
+        else {
+            wrong += (it == squares.end() || it->second != i % 1000 * (i % 1000));
+        }
+    }
+    cout << "Wrong values after 100000 inserts and 50000 erases: should be 0: " << wrong << endl;
+    cout << "Size: should be 50000: " << squares.size() << endl;
+    cout << endl;
+
+    // BSTMap
+    BSTMap<int, std::string> b;
+    int keys[] = {8, 3, 10, 1, 6, 14};
+    for (int k : keys) {
+        b[k] = std::to_string(k * 2);
+    }
+    b.print_tree();
+    cout << "Size: should be 6: " << b.size() << endl;
+    cout << "6: should be 12: " << b[6] << endl;
+    cout << "try_emplace 6 added: should be 0: " << b.try_emplace(6, "x").second << endl;
+    cout << "insert_or_assign 6 added: should be 0: " << b.insert_or_assign(6, "six").second << endl;
+    cout << "6: should be six: " << b.find(6)->second << endl;
+    cout << "Erase 8: should be 1: " << b.erase(8) << endl;
+    cout << "Erase 8 again: should be 0: " << b.erase(8) << endl;
+    cout << "In order: should be 1 3 6 10 14: ";
+    for (const MapEntry<int, std::string>& e : b) {
+        cout << e.first << ' ';
+    }
+    cout << endl;
+    cout << endl;
+
+    // comparators, transparent lookups take a std::string_view without building a key
+    AVLMap<std::string, int, NodePool, std::less<>> ages;
+    ages["ann"] = 31;
+    ages["bob"] = 27;
+    std::string_view who = "bob";
+    cout << "Find string_view bob: should be 27: " << ages.find(who)->second << endl;
+    cout << "Contains string_view cal: should be 0: " << ages.contains(std::string_view("cal")) << endl;
+    BSTMap<int, int, NodePool, std::greater<int>> down;
+    for (int i = 1; i <= 5; i++) {
+        down[i] = i * i;
+    }
+    cout << "Greater first: should be 5 4 3 2 1: ";
+    for (const MapEntry<int, int>& e : down) {
+        cout << e.first << ' ';
+    }
+    cout << endl;
+    return 0;
+}
@@ -0,0 +1,398 @@
+/*****************************************
+** File:    tree_print.h
+** Project: CSCE 221 Lab 4 Spring 2022
+** Author:  Naimur Rahman
+** Date:    03/21/2022
+** Section: 511
+** E-mail:  naimurrah01@tamu.edu
+** Description: Buffered output of trees for print_tree(), and the DOT, JSON and level order export formats
+**/
+#ifndef TREE_PRINT_H
+#define TREE_PRINT_H
+
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Formats the export_tree() of AVLTree and BinarySearchTree can write.
+//  - Rotated:    what print_tree() prints, the tree turned 90 degrees, root at the left
+//  - Dot:        a Graphviz digraph, left children leave from the bottom left of their parent
+//  - Json:       nested {"value": v, "left": ..., "right": ...} objects on one line
+//  - LevelOrder: one line per depth, "depth: values", from the root down
+enum class TreeFormat { Rotated, Dot, Json, LevelOrder };
+
+// max_depth for export_tree() that prints every level
+constexpr std::size_t NO_DEPTH_LIMIT = std::numeric_limits<std::size_t>::max();
+
+// Collects the text of a tree in a string and hands it to the stream in
+// large pieces, instead of writing (and with endl flushing) once per node.
+// Integers are formatted with std::to_chars, anything else with operator<<
+// into one stream kept for the whole tree, set up like the one written to.
+// Whatever is left is written when the writer goes away; the stream is never
+// flushed, that is left to its owner.
+class TreeWriter {
+private:
+    static constexpr std::size_t FLUSH_AT = 1 << 16; // bytes collected before they are written
+
+    std::ostream& os;            // stream written to
+    std::string buffer;          // text not written yet, keeps its capacity when emptied
+    std::ostringstream scratch;  // formats values std::to_chars cannot
+    std::string formatted;       // last value formatted by scratch
+    bool plainIntegers;          // os prints integers in decimal with no + sign, as std::to_chars does
+
+    // true for the integer types operator<< prints as numbers, not bool or the character types
+    template <typename T>
+    struct IsNumber : std::integral_constant<bool, std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+                                                       !std::is_same<T, char>::value &&
+                                                       !std::is_same<T, signed char>::value &&
+                                                       !std::is_same<T, unsigned char>::value> {};
+
+    //-------------------------------------------------------
+    // Name: format(const T& value)
+    // PreCondition:  value with an operator<<
+    // PostCondition: returns the text of value as os would print it
+    //---------------------------------------------------------
+    template <typename T>
+    const std::string& format(const T& value) {
+        this->scratch.str(std::string());
+        this->scratch << value;
+        this->formatted = this->scratch.str();
+        return this->formatted;
+    }
+
+public:
+    //-------------------------------------------------------
+    // Name: TreeWriter(std::ostream& os)
+    // PreCondition:  stream os to write to
+    // PostCondition: creates an empty writer formatting values the way os is set up to
+    //---------------------------------------------------------
+    explicit TreeWriter(std::ostream& os) : os(os) {
+        this->buffer.reserve(FLUSH_AT + 256);
+        this->scratch.copyfmt(os);
+        this->plainIntegers = (os.flags() & std::ios::basefield) == std::ios::dec && !(os.flags() & std::ios::showpos);
+    }
+
+    TreeWriter(const TreeWriter&) = delete;
+    TreeWriter& operator=(const TreeWriter&) = delete;
+
+    //-------------------------------------------------------
+    // Name: ~TreeWriter()
+    // PreCondition:  none
+    // PostCondition: writes what is left to the stream
+    //---------------------------------------------------------
+    ~TreeWriter() {
+        write();
+    }
+
+    //-------------------------------------------------------
+    // Name: write()
+    // PreCondition:  none
+    // PostCondition: writes the text collected so far to the stream and empties the buffer
+    //---------------------------------------------------------
+    void write() {
+        this->os.write(this->buffer.data(), static_cast<std::streamsize>(this->buffer.size()));
+        this->buffer.clear();
+    }
+
+    //-------------------------------------------------------
+    // Name: text(std::string_view s) / put(char c) / indent(std::size_t n)
+    // PreCondition:  text to add
+    // PostCondition: adds s, c or n spaces
+    //---------------------------------------------------------
+    TreeWriter& text(std::string_view s) {
+        this->buffer.append(s.data(), s.size());
+        return *this;
+    }
+
+    TreeWriter& put(char c) {
+        this->buffer.push_back(c);
+        return *this;
+    }
+
+    TreeWriter& indent(std::size_t n) {
+        this->buffer.append(n, ' ');
+        return *this;
+    }
+
+    //-------------------------------------------------------
+    // Name: endLine()
+    // PreCondition:  none
+    // PostCondition: ends the line, writing the buffer out once it is full
+    //---------------------------------------------------------
+    void endLine() {
+        this->buffer.push_back('\n');
+        if (this->buffer.size() >= FLUSH_AT) {
+            write();
+        }
+    }
+
+    //-------------------------------------------------------
+    // Name: value(const T& v)
+    // PreCondition:  value v with an operator<<
+    // PostCondition: adds v as operator<< would print it to the stream
+    //---------------------------------------------------------
+    template <typename T>
+    TreeWriter& value(const T& v) {
+        if constexpr (IsNumber<T>::value) {
+            if (this->plainIntegers) {
+                char digits[std::numeric_limits<T>::digits10 + 3]; // sign and one digit digits10 leaves out
+                std::to_chars_result r = std::to_chars(digits, digits + sizeof(digits), v);
+                this->buffer.append(digits, r.ptr);
+                return *this;
+            }
+        }
+        return text(format(v));
+    }
+
+    //-------------------------------------------------------
+    // Name: quoted(const T& v)
+    // PreCondition:  value v with an operator<<
+    // PostCondition: adds v as a double quoted string, escaping quotes, backslashes and control characters
+    //                the way JSON does, which DOT labels read the same way
+    //---------------------------------------------------------
+    template <typename T>
+    TreeWriter& quoted(const T& v) {
+        const std::string& s = format(v);
+        put('"');
+        for (char c : s) {
+            if (c == '"' || c == '\\') {
+                put('\\').put(c);
+            }
+            else if (static_cast<unsigned char>(c) < 0x20) {
+                static const char hex[] = "0123456789abcdef";
+                text("\\u00").put(hex[(c >> 4) & 0xf]).put(hex[c & 0xf]);
+            }
+            else {
+                put(c);
+            }
+        }
+        return put('"');
+    }
+
+    //-------------------------------------------------------
+    // Name: jsonValue(const T& v)
+    // PreCondition:  value v with an operator<<
+    // PostCondition: adds v as a JSON number if it is a finite number, as a JSON string if not
+    //---------------------------------------------------------
+    template <typename T>
+    TreeWriter& jsonValue(const T& v) {
+        if constexpr (IsNumber<T>::value) {
+            return value(v);
+        }
+        else if constexpr (std::is_floating_point<T>::value) {
+            return std::isfinite(v) ? value(v) : quoted(v);
+        }
+        else {
+            return quoted(v);
+        }
+    }
+};
+
+// The writers below work on any binary tree whose nodes have left, right and
+// data members, and walk it with a stack of their own, so a BinarySearchTree
+// that has become a list a million nodes long prints without running out of
+// call stack. The root is at depth 0 and nodes deeper than maxDepth are left out.
+
+//-------------------------------------------------------
+// Name: write_rotated(TreeWriter& out, const Node* root, std::size_t maxDepth, Shown shown)
+// PreCondition:  writer out, root of the tree, nullptr if empty, the deepest level to print, and shown telling
+//                whether a node's value is printed
+// PostCondition: writes the tree rotated 90 degrees, one value per line indented two spaces per level,
+//                right subtree above its parent and left subtree below. Nodes shown turns down are walked
+//                through without a line of their own.
+//---------------------------------------------------------
+template <typename Node, typename Shown>
+void write_rotated(TreeWriter& out, const Node* root, std::size_t maxDepth, Shown shown) {
+    std::vector<std::pair<const Node*, std::size_t>> stack; // nodes whose right subtree is being written
+    const Node* p = root;
+    std::size_t depth = 0;
+    while (true) {
+        for (; p != nullptr && depth <= maxDepth; p = p->right, depth++) {
+            stack.push_back({p, depth});
+        }
+        if (stack.empty()) {
+            return;
+        }
+        std::pair<const Node*, std::size_t> top = stack.back();
+        stack.pop_back();
+        if (shown(*top.first)) {
+            out.indent(2 * top.second).value(top.first->data).endLine();
+        }
+        p = top.first->left;
+        depth = top.second + 1;
+    }
+}
+
+//-------------------------------------------------------
+// Name: write_rotated(TreeWriter& out, const Node* root, std::size_t maxDepth)
+// PreCondition:  writer out, root of the tree, nullptr if empty, and the deepest level to print
+// PostCondition: writes every node of the tree rotated 90 degrees, as above
+//---------------------------------------------------------
+template <typename Node>
+void write_rotated(TreeWriter& out, const Node* root, std::size_t maxDepth) {
+    write_rotated(out, root, maxDepth, [](const Node&) { return true; });
+}
+
+//-------------------------------------------------------
+// Name: write_dot(TreeWriter& out, const Node* root, std::size_t maxDepth)
+// PreCondition:  writer out, root of the tree, nullptr if empty, and the deepest level to print
+// PostCondition: writes the tree as a Graphviz digraph. Nodes are named n0, n1, ... in preorder, and a node
+//                at maxDepth with children gets a "..." child in their place.
+//---------------------------------------------------------
+template <typename Node>
+void write_dot(TreeWriter& out, const Node* root, std::size_t maxDepth) {
+    struct Visit {
+        const Node* n;
+        std::size_t depth;
+        std::size_t parent;   // name of the parent
+        const char* port;     // side of the parent the edge leaves from, nullptr for the root
+    };
+    out.text("digraph tree {").endLine();
+    out.text("  node [shape=circle];").endLine();
+    std::vector<Visit> stack;
+    if (root != nullptr) {
+        stack.push_back({root, 0, 0, nullptr});
+    }
+    std::size_t next = 0; // name of the next node
+    while (!stack.empty()) {
+        Visit v = stack.back();
+        stack.pop_back();
+        std::size_t id = next++;
+        out.text("  n").value(id).text(" [label=").quoted(v.n->data).text("];").endLine();
+        if (v.port != nullptr) {
+            out.text("  n").value(v.parent).put(':').text(v.port).text(" -> n").value(id).put(';').endLine();
+        }
+        if (v.depth == maxDepth) {
+            if (v.n->left != nullptr || v.n->right != nullptr) {
+                out.text("  n").value(id).text("_more [label=\"...\", shape=plaintext];").endLine();
+                out.text("  n").value(id).text(" -> n").value(id).text("_more;").endLine();
+            }
+            continue;
+        }
+        if (v.n->right != nullptr) { // pushed first so the left subtree is named first
+            stack.push_back({v.n->right, v.depth + 1, id, "se"});
+        }
+        if (v.n->left != nullptr) {
+            stack.push_back({v.n->left, v.depth + 1, id, "sw"});
+        }
+    }
+    out.put('}').endLine();
+}
+
+//-------------------------------------------------------
+// Name: write_json(TreeWriter& out, const Node* root, std::size_t maxDepth)
+// PreCondition:  writer out, root of the tree, nullptr if empty, and the deepest level to print
+// PostCondition: writes the tree as {"value": v, "left": l, "right": r} objects nested on one line, with null
+//                for a missing child or an empty tree. A node at maxDepth with children is written as
+//                {"value": v, "truncated": true} instead.
+//---------------------------------------------------------
+template <typename Node>
+void write_json(TreeWriter& out, const Node* root, std::size_t maxDepth) {
+    struct Visit {
+        const Node* n;
+        std::size_t depth;
+        int stage; // 0 before the value, 1 before the left child, 2 before the right child, 3 before the }
+    };
+    if (root == nullptr) {
+        out.text("null").endLine();
+        return;
+    }
+    std::vector<Visit> stack;
+    stack.push_back({root, 0, 0});
+    while (!stack.empty()) {
+        Visit& v = stack.back();
+        const Node* child = nullptr;
+        switch (v.stage++) {
+        case 0:
+            out.text("{\"value\": ").jsonValue(v.n->data);
+            if (v.depth == maxDepth && (v.n->left != nullptr || v.n->right != nullptr)) {
+                out.text(", \"truncated\": true");
+                v.stage = 3;
+            }
+            continue;
+        case 1:
+            out.text(", \"left\": ");
+            child = v.n->left;
+            break;
+        case 2:
+            out.text(", \"right\": ");
+            child = v.n->right;
+            break;
+        default:
+            out.put('}');
+            stack.pop_back();
+            continue;
+        }
+        if (child != nullptr) {
+            stack.push_back({child, v.depth + 1, 0}); // v is not used after this
+        }
+        else {
+            out.text("null");
+        }
+    }
+    out.endLine();
+}
+
+//-------------------------------------------------------
+// Name: write_level_order(TreeWriter& out, const Node* root, std::size_t maxDepth)
+// PreCondition:  writer out, root of the tree, nullptr if empty, and the deepest level to print
+// PostCondition: writes one line per depth from the root down, "depth: values" with the values of that depth
+//                from left to right
+//---------------------------------------------------------
+template <typename Node>
+void write_level_order(TreeWriter& out, const Node* root, std::size_t maxDepth) {
+    std::vector<const Node*> level;
+    std::vector<const Node*> below;
+    if (root != nullptr) {
+        level.push_back(root);
+    }
+    for (std::size_t depth = 0; !level.empty() && depth <= maxDepth; depth++) {
+        out.value(depth).put(':');
+        below.clear();
+        for (const Node* n : level) {
+            out.put(' ').value(n->data);
+            if (n->left != nullptr) {
+                below.push_back(n->left);
+            }
+            if (n->right != nullptr) {
+                below.push_back(n->right);
+            }
+        }
+        out.endLine();
+        level.swap(below);
+    }
+}
+
+//-------------------------------------------------------
+// Name: write_tree(std::ostream& os, const Node* root, TreeFormat format, std::size_t maxDepth)
+// PreCondition:  stream os, root of the tree, nullptr if empty, the format and the deepest level to print
+// PostCondition: writes the tree to os in the format, buffered, without flushing os
+//---------------------------------------------------------
+template <typename Node>
+void write_tree(std::ostream& os, const Node* root, TreeFormat format, std::size_t maxDepth) {
+    TreeWriter out(os);
+    switch (format) {
+    case TreeFormat::Rotated:
+        write_rotated(out, root, maxDepth);
+        break;
+    case TreeFormat::Dot:
+        write_dot(out, root, maxDepth);
+        break;
+    case TreeFormat::Json:
+        write_json(out, root, maxDepth);
+        break;
+    case TreeFormat::LevelOrder:
+        write_level_order(out, root, maxDepth);
+        break;
+    }
+}
+
+#endif